@@ -0,0 +1,143 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include "arena.h"
+
+/*
+* Implementation of an arena allocator. The blocks are kept in a linked
+* list, newest first, and allocations are cut from the front of the free
+* part of the newest block.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-06-26: v1.0, first public version.
+*   2022-07-14: v1.1, added arena_strndup().
+*/
+
+#define DEFAULT_BLOCK_SIZE 4096
+// All allocations are rounded up to a multiple of ALIGNMENT bytes.
+#define ALIGNMENT 16
+
+/*Defines a block of memory. The usable memory follows the header */
+typedef struct block
+{
+        struct block *next;
+        size_t size;
+} block;
+/*Defines the arena structure */
+struct arena
+{
+        block *blocks;
+        char *free_ptr;
+        size_t free_size;
+        size_t next_size;
+};
+/**
+* round_up() - Round a size up to a multiple of the alignment.
+* @size: Size in bytes.
+*
+* Returns: The rounded size.
+*/
+static size_t round_up(size_t size)
+{
+        return (size + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1);
+}
+/**
+* add_block() - Add a new block that can hold at least size bytes.
+* @a: Arena to manipulate.
+* @size: Number of bytes that must fit.
+*
+* Returns: Nothing.
+*/
+static void add_block(arena *a, size_t size)
+{
+        size_t header = round_up(sizeof(block));
+        size_t block_size = a->next_size;
+        while (block_size < size)
+        {
+                block_size *= 2;
+        }
+        block *b = malloc(header + block_size);
+        b->size = block_size;
+        b->next = a->blocks;
+        a->blocks = b;
+        a->free_ptr = (char *)b + header;
+        a->free_size = block_size;
+        a->next_size = 2 * block_size;
+}
+/**
+* arena_empty() - Create an empty arena.
+* @block_size: Size in bytes of the first block, or 0 for a default size.
+*
+* Returns: A pointer to the new arena.
+*/
+arena *arena_empty(size_t block_size)
+{
+        arena *a = calloc(1, sizeof(*a));
+        a->next_size = block_size > 0 ? round_up(block_size) : DEFAULT_BLOCK_SIZE;
+        return a;
+}
+/**
+* arena_alloc() - Allocate memory from an arena.
+* @a: Arena to allocate from.
+* @size: Number of bytes.
+*
+* Returns: A pointer to the memory.
+*/
+void *arena_alloc(arena *a, size_t size)
+{
+        size = round_up(size > 0 ? size : 1);
+        if (size > a->free_size)
+        {
+                add_block(a, size);
+        }
+        void *p = a->free_ptr;
+        a->free_ptr += size;
+        a->free_size -= size;
+        return p;
+}
+/**
+* arena_strdup() - Copy a string into an arena.
+* @a: Arena to allocate from.
+* @s: String to copy.
+*
+* Returns: A pointer to the copy.
+*/
+char *arena_strdup(arena *a, const char *s)
+{
+        return arena_strndup(a, s, strlen(s));
+}
+/**
+* arena_strndup() - Copy a piece of a string into an arena.
+* @a: Arena to allocate from.
+* @s: First character of the piece, which need not be terminated.
+* @length: Number of characters in the piece.
+*
+* Returns: A pointer to the copy, with a terminating '\0' added.
+*/
+char *arena_strndup(arena *a, const char *s, size_t length)
+{
+        char *copy = arena_alloc(a, length + 1);
+        memcpy(copy, s, length);
+        copy[length] = '\0';
+        return copy;
+}
+/**
+* arena_kill() - Destroy an arena and all memory allocated from it.
+* @a: Arena to destroy.
+*
+* Returns: Nothing.
+*/
+void arena_kill(arena *a)
+{
+        while (a->blocks != NULL)
+        {
+                block *next = a->blocks->next;
+                free(a->blocks);
+                a->blocks = next;
+        }
+        free(a);
+}
@@ -0,0 +1,75 @@
+#ifndef __ARENA_H
+#define __ARENA_H
+
+#include <stddef.h>
+
+/*
+ * Declaration of an arena (bump) allocator. Memory is handed out from
+ * large blocks, and everything allocated from an arena is released at
+ * once by arena_kill(). Single allocations can not be freed. After use,
+ * the function arena_kill() must be called to de-allocate the blocks.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-06-26: v1.0, first public version.
+ *   2022-07-14: v1.1, added arena_strndup().
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct arena arena;
+
+// =================== ARENA INTERFACE ======================
+
+/**
+ * arena_empty() - Create an empty arena.
+ * @block_size: Size in bytes of the first block, or 0 for a default size.
+ *
+ * Each new block is twice the size of the previous one, so the number
+ * of blocks grows logarithmically with the memory used.
+ *
+ * Returns: A pointer to the new arena.
+ */
+arena *arena_empty(size_t block_size);
+
+/**
+ * arena_alloc() - Allocate memory from an arena.
+ * @a: Arena to allocate from.
+ * @size: Number of bytes.
+ *
+ * The memory is suitably aligned for any type and is not initialized.
+ *
+ * Returns: A pointer to the memory.
+ */
+void *arena_alloc(arena *a, size_t size);
+
+/**
+ * arena_strdup() - Copy a string into an arena.
+ * @a: Arena to allocate from.
+ * @s: String to copy.
+ *
+ * Returns: A pointer to the copy.
+ */
+char *arena_strdup(arena *a, const char *s);
+
+/**
+ * arena_strndup() - Copy a piece of a string into an arena.
+ * @a: Arena to allocate from.
+ * @s: First character of the piece, which need not be terminated.
+ * @length: Number of characters in the piece.
+ *
+ * Returns: A pointer to the copy, with a terminating '\0' added.
+ */
+char *arena_strndup(arena *a, const char *s, size_t length);
+
+/**
+ * arena_kill() - Destroy an arena and all memory allocated from it.
+ * @a: Arena to destroy.
+ *
+ * Returns: Nothing.
+ */
+void arena_kill(arena *a);
+
+#endif
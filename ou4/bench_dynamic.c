@@ -0,0 +1,277 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "graph.h"
+#include "dynreach.h"
+
+/*
+* Benchmark of reachability queries while routes are added and cancelled.
+* Runs the same random mix of edge insertions, edge deletions and queries
+* against the dynamic reachability layer (dynreach.c) and against a plain
+* search of the live graph, and prints the time of each. The answers of
+* the two runs are compared.
+*
+* Usage: bench_dynamic [update-percent [cancel-percent [nodes [operations]]]]
+*   update-percent  Share of the operations that change a route. Without
+*                   arguments a range of shares is measured.
+*   cancel-percent  Share of the changes that cancel a route instead of
+*                   adding one. The default is 50.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-07-07: v1.0, first public version.
+*/
+
+#define NODES 20000
+#define OPERATIONS 20000
+#define EDGES_PER_NODE 1.5
+#define NAMESIZE 16
+
+/*Defines the operations of a run */
+typedef enum op_kind
+{
+        QUERY,
+        ADD,
+        CANCEL
+} op_kind;
+typedef struct op
+{
+        op_kind kind;
+        int src;
+        int dest;
+} op;
+/*Defines the result of a run */
+typedef struct run_result
+{
+        double seconds;
+        long found;
+        dynreach_stats stats;
+} run_result;
+
+/**
+* next_random() - Simple linear congruential generator, so that every run
+* uses the same operations.
+* @state: Generator state.
+*
+* Returns: A pseudo-random number.
+*/
+static unsigned int next_random(unsigned long *state)
+{
+        *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+        return (unsigned int)(*state >> 33);
+}
+/**
+* make_ops() - Create the start edges and the operations of a run.
+* @nodes: Number of nodes.
+* @edges: Number of start edges, stored first in the returned array.
+* @ops: Number of operations, stored after the start edges.
+* @update: Percent of the operations that change a route.
+* @cancel: Percent of the changes that cancel a route.
+*
+* A cancelled route is always one that exists at that point of the run.
+*
+* Returns: Array of edges + ops operations.
+*/
+static op *make_ops(int nodes, int edges, int ops, int update, int cancel)
+{
+        unsigned long state = 1;
+        op *all = malloc((edges + ops) * sizeof(*all));
+        //Indices in all of the routes that exist
+        int *live = malloc((edges + ops) * sizeof(*live));
+        int live_count = 0;
+        for (int i = 0; i < edges + ops; i++)
+        {
+                op *o = &all[i];
+                o->kind = QUERY;
+                if (i < edges || (int)(next_random(&state) % 100) < update)
+                {
+                        o->kind = ADD;
+                        if (i >= edges && live_count > 0 &&
+                            (int)(next_random(&state) % 100) < cancel)
+                        {
+                                o->kind = CANCEL;
+                        }
+                }
+                if (o->kind == CANCEL)
+                {
+                        int k = next_random(&state) % live_count;
+                        *o = all[live[k]];
+                        o->kind = CANCEL;
+                        live[k] = live[--live_count];
+                        continue;
+                }
+                o->src = next_random(&state) % nodes;
+                o->dest = next_random(&state) % nodes;
+                if (o->kind == ADD)
+                {
+                        live[live_count++] = i;
+                }
+        }
+        free(live);
+        return all;
+}
+/**
+* live_path() - Breadth-first search of the live graph.
+* @g: Graph to search.
+* @queue: Room for all nodes of the graph.
+* @src: Origin node.
+* @dest: Destination node.
+*
+* Returns: True if dest can be reached from src, otherwise false.
+*/
+static bool live_path(graph *g, node **queue, node *src, node *dest)
+{
+        if (src == dest)
+        {
+                return true;
+        }
+        graph_reset_seen(g);
+        int head = 0;
+        int tail = 0;
+        graph_node_set_seen(g, src, true);
+        queue[tail++] = src;
+        while (head < tail)
+        {
+                node *v = queue[head++];
+                graph_pos p = graph_neighbour_first(g, v);
+                for (; !graph_neighbour_is_end(g, p); p = graph_neighbour_next(g, p))
+                {
+                        node *w = graph_neighbour_inspect(g, p);
+                        if (w == dest)
+                        {
+                                return true;
+                        }
+                        if (!graph_node_is_seen(g, w))
+                        {
+                                graph_node_set_seen(g, w, true);
+                                queue[tail++] = w;
+                        }
+                }
+        }
+        return false;
+}
+/**
+* run() - Build a graph and run the operations on it.
+* @names: Node names.
+* @nodes: Number of nodes.
+* @all: Start edges followed by the operations.
+* @edges: Number of start edges.
+* @ops: Number of operations.
+* @dynamic: True to answer with the dynamic layer, false to search the
+* live graph.
+*
+* Only the operations are timed, not building the start graph.
+*
+* Returns: The time, the number of queries with a path and the counters.
+*/
+static run_result run(char **names, int nodes, const op *all, int edges,
+                      int ops, bool dynamic)
+{
+        run_result r = { 0, 0, { 0, 0, 0, 0 } };
+        graph *g = graph_empty(nodes);
+        node **by_index = malloc(nodes * sizeof(*by_index));
+        for (int i = 0; i < nodes; i++)
+        {
+                g = graph_insert_node(g, names[i]);
+                by_index[i] = graph_find_node(g, names[i]);
+        }
+        for (int i = 0; i < edges; i++)
+        {
+                g = graph_insert_edge(g, by_index[all[i].src], by_index[all[i].dest]);
+        }
+        node **queue = malloc(nodes * sizeof(*queue));
+        dynreach *d = dynamic ? dynreach_empty(g) : NULL;
+
+        clock_t start = clock();
+        for (int i = edges; i < edges + ops; i++)
+        {
+                node *src = by_index[all[i].src];
+                node *dest = by_index[all[i].dest];
+                if (all[i].kind == ADD)
+                {
+                        g = dynamic ? dynreach_insert_edge(d, src, dest)
+                                    : graph_insert_edge(g, src, dest);
+                }
+                else if (all[i].kind == CANCEL)
+                {
+                        g = dynamic ? dynreach_delete_edge(d, src, dest)
+                                    : graph_delete_edge(g, src, dest);
+                }
+                else if (dynamic ? dynreach_path_exists(d, src, dest)
+                                 : live_path(g, queue, src, dest))
+                {
+                        r.found++;
+                }
+        }
+        r.seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        if (dynamic)
+        {
+                r.stats = dynreach_get_stats(d);
+                dynreach_kill(d);
+        }
+        free(queue);
+        free(by_index);
+        graph_kill(g);
+        return r;
+}
+/**
+* measure() - Run one mix of operations both ways and print the times.
+* @names: Node names.
+* @nodes: Number of nodes.
+* @ops: Number of operations.
+* @update: Percent of the operations that change a route.
+* @cancel: Percent of the changes that cancel a route.
+*
+* Returns: Nothing.
+*/
+static void measure(char **names, int nodes, int ops, int update, int cancel)
+{
+        int edges = (int)(EDGES_PER_NODE * nodes);
+        op *all = make_ops(nodes, edges, ops, update, cancel);
+        run_result dyn = run(names, nodes, all, edges, ops, true);
+        run_result live = run(names, nodes, all, edges, ops, false);
+        printf("%8d %8d %12.4f %12.4f %8ld %8ld %8ld%s\n", update, cancel,
+               dyn.seconds, live.seconds, dyn.stats.merges, dyn.stats.repairs,
+               dyn.stats.splits, dyn.found == live.found ? "" : "  answers differ!");
+        free(all);
+}
+
+int main(int argc, const char **argv)
+{
+        int update = argc > 1 ? atoi(argv[1]) : -1;
+        int cancel = argc > 2 ? atoi(argv[2]) : 50;
+        int nodes = argc > 3 ? atoi(argv[3]) : NODES;
+        int ops = argc > 4 ? atoi(argv[4]) : OPERATIONS;
+
+        char **names = malloc(nodes * sizeof(*names));
+        for (int i = 0; i < nodes; i++)
+        {
+                names[i] = malloc(NAMESIZE);
+                snprintf(names[i], NAMESIZE, "N%d", i);
+        }
+        printf("%d nodes, %d operations\n", nodes, ops);
+        printf("%8s %8s %12s %12s %8s %8s %8s\n", "update%", "cancel%",
+               "dynamic s", "live s", "merges", "repairs", "splits");
+        if (update >= 0)
+        {
+                measure(names, nodes, ops, update, cancel);
+        }
+        else
+        {
+                int shares[] = { 0, 1, 10, 50 };
+                for (int i = 0; i < 4; i++)
+                {
+                        measure(names, nodes, ops, shares[i], cancel);
+                }
+        }
+        for (int i = 0; i < nodes; i++)
+        {
+                free(names[i]);
+        }
+        free(names);
+        return 0;
+}
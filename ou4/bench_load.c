@@ -0,0 +1,129 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "graph.h"
+
+/*
+* Benchmark of graph loading. Builds graphs of increasing size from
+* synthetic edge lists the same way read_map() in is_connected.c does,
+* and prints the time per edge. With O(1) node lookup the time per edge
+* should stay roughly constant as the map grows.
+*
+* Usage: bench_load [max_nodes]
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-06-20: v1.0, first public version.
+*/
+
+#define EDGES_PER_NODE 4
+#define NAMESIZE 16
+
+/**
+* next_random() - Simple linear congruential generator, so that every run
+* uses the same maps.
+* @state: Generator state.
+*
+* Returns: A pseudo-random number.
+*/
+static unsigned int next_random(unsigned long *state)
+{
+        *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+        return (unsigned int)(*state >> 33);
+}
+/**
+* make_names() - Create the node names N0, N1, ...
+* @nodes: Number of names.
+*
+* Returns: Array of names. Must be freed with free_names().
+*/
+static char **make_names(int nodes)
+{
+        char **names = malloc(nodes * sizeof(*names));
+        for (int i = 0; i < nodes; i++)
+        {
+                names[i] = malloc(NAMESIZE);
+                snprintf(names[i], NAMESIZE, "N%d", i);
+        }
+        return names;
+}
+/**
+* free_names() - Free names created by make_names().
+* @names: Array of names.
+* @nodes: Number of names.
+*
+* Returns: Nothing.
+*/
+static void free_names(char **names, int nodes)
+{
+        for (int i = 0; i < nodes; i++)
+        {
+                free(names[i]);
+        }
+        free(names);
+}
+/**
+* time_load() - Build a graph from an edge list and time it.
+* @names: Node names.
+* @nodes: Number of nodes.
+* @src: Index of the origin name for each edge.
+* @dest: Index of the destination name for each edge.
+* @edges: Number of edges.
+*
+* Returns: Elapsed time in seconds.
+*/
+static double time_load(char **names, int nodes, const int *src,
+                        const int *dest, int edges)
+{
+        clock_t start = clock();
+        graph *g = graph_empty(0);
+        for (int i = 0; i < edges; i++)
+        {
+                const char *s1 = names[src[i]];
+                const char *s2 = names[dest[i]];
+                if (graph_find_node(g, s1) == NULL)
+                {
+                        g = graph_insert_node(g, s1);
+                }
+                if (graph_find_node(g, s2) == NULL)
+                {
+                        g = graph_insert_node(g, s2);
+                }
+                node *n1 = graph_find_node(g, s1);
+                node *n2 = graph_find_node(g, s2);
+                g = graph_insert_edge(g, n1, n2);
+        }
+        double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+        graph_kill(g);
+        return elapsed;
+}
+
+int main(int argc, const char **argv)
+{
+        int max_nodes = argc > 1 ? atoi(argv[1]) : 128000;
+        unsigned long state = 1;
+
+        printf("%10s %10s %12s %12s\n", "nodes", "edges", "seconds", "ns/edge");
+        for (int nodes = 1000; nodes <= max_nodes; nodes *= 2)
+        {
+                int edges = EDGES_PER_NODE * nodes;
+                char **names = make_names(nodes);
+                int *src = malloc(edges * sizeof(*src));
+                int *dest = malloc(edges * sizeof(*dest));
+                for (int i = 0; i < edges; i++)
+                {
+                        src[i] = next_random(&state) % nodes;
+                        dest[i] = next_random(&state) % nodes;
+                }
+                double seconds = time_load(names, nodes, src, dest, edges);
+                printf("%10d %10d %12.4f %12.1f\n", nodes, edges, seconds,
+                       1e9 * seconds / edges);
+                free(src);
+                free(dest);
+                free_names(names, nodes);
+        }
+        return 0;
+}
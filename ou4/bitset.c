@@ -0,0 +1,214 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "bitset.h"
+
+/*
+* Implementation of fixed-size bitsets of 64-bit words. The whole-set
+* operations use AVX2 or SSE2 when the compiler targets them, with a plain
+* word loop for the remaining words.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-06-22: v1.0, first public version.
+*/
+
+/**
+* bitset_words() - Return the number of words needed for a bitset.
+* @bits: Number of bits.
+*
+* Returns: The number of 64-bit words.
+*/
+int bitset_words(int bits)
+{
+        return (bits + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+}
+/**
+* bitset_empty() - Create a bitset with all bits cleared.
+* @bits: Number of bits.
+*
+* Returns: A pointer to the words of the bitset.
+*/
+uint64_t *bitset_empty(int bits)
+{
+        int words = bitset_words(bits);
+        return calloc(words > 0 ? words : 1, sizeof(uint64_t));
+}
+/**
+* bitset_set() - Set a bit.
+* @b: Bitset to manipulate.
+* @i: Bit to set.
+*
+* Returns: Nothing.
+*/
+void bitset_set(uint64_t *b, int i)
+{
+        b[i / BITSET_WORD_BITS] |= (uint64_t)1 << (i % BITSET_WORD_BITS);
+}
+/**
+* bitset_unset() - Clear a bit.
+* @b: Bitset to manipulate.
+* @i: Bit to clear.
+*
+* Returns: Nothing.
+*/
+void bitset_unset(uint64_t *b, int i)
+{
+        b[i / BITSET_WORD_BITS] &= ~((uint64_t)1 << (i % BITSET_WORD_BITS));
+}
+/**
+* bitset_test() - Check a bit.
+* @b: Bitset to inspect.
+* @i: Bit to check.
+*
+* Returns: True if the bit is set, otherwise false.
+*/
+bool bitset_test(const uint64_t *b, int i)
+{
+        return (b[i / BITSET_WORD_BITS] >> (i % BITSET_WORD_BITS)) & 1;
+}
+/**
+* bitset_clear() - Clear all bits.
+* @b: Bitset to manipulate.
+* @words: Number of words in the bitset.
+*
+* Returns: Nothing.
+*/
+void bitset_clear(uint64_t *b, int words)
+{
+        memset(b, 0, words * sizeof(*b));
+}
+/**
+* bitset_or() - Union of two bitsets, dst |= src.
+* @dst: Bitset to manipulate.
+* @src: Bitset to add.
+* @words: Number of words in the bitsets.
+*
+* Returns: Nothing.
+*/
+void bitset_or(uint64_t *dst, const uint64_t *src, int words)
+{
+        int i = 0;
+#ifdef __AVX2__
+        for (; i + 4 <= words; i += 4)
+        {
+                __m256i a = _mm256_loadu_si256((const __m256i *)(dst + i));
+                __m256i b = _mm256_loadu_si256((const __m256i *)(src + i));
+                _mm256_storeu_si256((__m256i *)(dst + i), _mm256_or_si256(a, b));
+        }
+#elif defined(__SSE2__)
+        for (; i + 2 <= words; i += 2)
+        {
+                __m128i a = _mm_loadu_si128((const __m128i *)(dst + i));
+                __m128i b = _mm_loadu_si128((const __m128i *)(src + i));
+                _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(a, b));
+        }
+#endif
+        for (; i < words; i++)
+        {
+                dst[i] |= src[i];
+        }
+}
+/**
+* bitset_andnot() - Difference of two bitsets, dst &= ~src.
+* @dst: Bitset to manipulate.
+* @src: Bitset to remove.
+* @words: Number of words in the bitsets.
+*
+* Returns: Nothing.
+*/
+void bitset_andnot(uint64_t *dst, const uint64_t *src, int words)
+{
+        int i = 0;
+#ifdef __AVX2__
+        for (; i + 4 <= words; i += 4)
+        {
+                __m256i a = _mm256_loadu_si256((const __m256i *)(dst + i));
+                __m256i b = _mm256_loadu_si256((const __m256i *)(src + i));
+                //andnot computes ~first & second
+                _mm256_storeu_si256((__m256i *)(dst + i), _mm256_andnot_si256(b, a));
+        }
+#elif defined(__SSE2__)
+        for (; i + 2 <= words; i += 2)
+        {
+                __m128i a = _mm_loadu_si128((const __m128i *)(dst + i));
+                __m128i b = _mm_loadu_si128((const __m128i *)(src + i));
+                //andnot computes ~first & second
+                _mm_storeu_si128((__m128i *)(dst + i), _mm_andnot_si128(b, a));
+        }
+#endif
+        for (; i < words; i++)
+        {
+                dst[i] &= ~src[i];
+        }
+}
+/**
+* bitset_any() - Check if any bit is set.
+* @b: Bitset to inspect.
+* @words: Number of words in the bitset.
+*
+* Returns: True if at least one bit is set, otherwise false.
+*/
+bool bitset_any(const uint64_t *b, int words)
+{
+        for (int i = 0; i < words; i++)
+        {
+                if (b[i])
+                {
+                        return true;
+                }
+        }
+        return false;
+}
+/**
+* bitset_count() - Count the set bits.
+* @b: Bitset to inspect.
+* @words: Number of words in the bitset.
+*
+* Returns: The number of set bits.
+*/
+int bitset_count(const uint64_t *b, int words)
+{
+        int cnt = 0;
+        for (int i = 0; i < words; i++)
+        {
+                cnt += __builtin_popcountll(b[i]);
+        }
+        return cnt;
+}
+/**
+* bitset_next() - Find the next set bit.
+* @b: Bitset to inspect.
+* @words: Number of words in the bitset.
+* @from: First bit to consider.
+*
+* Returns: The index of the first set bit >= from, or -1 if there is none.
+*/
+int bitset_next(const uint64_t *b, int words, int from)
+{
+        int w = from / BITSET_WORD_BITS;
+        if (w >= words)
+        {
+                return -1;
+        }
+        //Mask away the bits before from in the first word
+        uint64_t word = b[w] & (~(uint64_t)0 << (from % BITSET_WORD_BITS));
+        while (!word)
+        {
+                if (++w == words)
+                {
+                        return -1;
+                }
+                word = b[w];
+        }
+        return w * BITSET_WORD_BITS + __builtin_ctzll(word);
+}
@@ -0,0 +1,128 @@
+#ifndef __BITSET_H
+#define __BITSET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Declaration of fixed-size bitsets stored as arrays of 64-bit words.
+ * Bit i is stored in word i/64 at position i%64. The whole-set
+ * operations work a word (or a SIMD register) at a time. A bitset is
+ * allocated with bitset_empty() and de-allocated with free().
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-06-22: v1.0, first public version.
+ */
+
+// Number of bits in a bitset word.
+#define BITSET_WORD_BITS 64
+
+// =================== BITSET INTERFACE ======================
+
+/**
+ * bitset_words() - Return the number of words needed for a bitset.
+ * @bits: Number of bits.
+ *
+ * Returns: The number of 64-bit words.
+ */
+int bitset_words(int bits);
+
+/**
+ * bitset_empty() - Create a bitset with all bits cleared.
+ * @bits: Number of bits.
+ *
+ * Returns: A pointer to the words of the bitset. Must be free()-d.
+ */
+uint64_t *bitset_empty(int bits);
+
+/**
+ * bitset_set() - Set a bit.
+ * @b: Bitset to manipulate.
+ * @i: Bit to set.
+ *
+ * Returns: Nothing.
+ */
+void bitset_set(uint64_t *b, int i);
+
+/**
+ * bitset_unset() - Clear a bit.
+ * @b: Bitset to manipulate.
+ * @i: Bit to clear.
+ *
+ * Returns: Nothing.
+ */
+void bitset_unset(uint64_t *b, int i);
+
+/**
+ * bitset_test() - Check a bit.
+ * @b: Bitset to inspect.
+ * @i: Bit to check.
+ *
+ * Returns: True if the bit is set, otherwise false.
+ */
+bool bitset_test(const uint64_t *b, int i);
+
+/**
+ * bitset_clear() - Clear all bits.
+ * @b: Bitset to manipulate.
+ * @words: Number of words in the bitset.
+ *
+ * Returns: Nothing.
+ */
+void bitset_clear(uint64_t *b, int words);
+
+/**
+ * bitset_or() - Union of two bitsets, dst |= src.
+ * @dst: Bitset to manipulate.
+ * @src: Bitset to add.
+ * @words: Number of words in the bitsets.
+ *
+ * Returns: Nothing.
+ */
+void bitset_or(uint64_t *dst, const uint64_t *src, int words);
+
+/**
+ * bitset_andnot() - Difference of two bitsets, dst &= ~src.
+ * @dst: Bitset to manipulate.
+ * @src: Bitset to remove.
+ * @words: Number of words in the bitsets.
+ *
+ * Returns: Nothing.
+ */
+void bitset_andnot(uint64_t *dst, const uint64_t *src, int words);
+
+/**
+ * bitset_any() - Check if any bit is set.
+ * @b: Bitset to inspect.
+ * @words: Number of words in the bitset.
+ *
+ * Returns: True if at least one bit is set, otherwise false.
+ */
+bool bitset_any(const uint64_t *b, int words);
+
+/**
+ * bitset_count() - Count the set bits.
+ * @b: Bitset to inspect.
+ * @words: Number of words in the bitset.
+ *
+ * Returns: The number of set bits.
+ */
+int bitset_count(const uint64_t *b, int words);
+
+/**
+ * bitset_next() - Find the next set bit.
+ * @b: Bitset to inspect.
+ * @words: Number of words in the bitset.
+ * @from: First bit to consider.
+ *
+ * Skips whole zero words and finds the bit within a word with a
+ * count-trailing-zeros instruction.
+ *
+ * Returns: The index of the first set bit >= from, or -1 if there is none.
+ */
+int bitset_next(const uint64_t *b, int words, int from);
+
+#endif
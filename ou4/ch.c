@@ -0,0 +1,820 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "graph.h"
+#include "heap.h"
+#include "ch.h"
+
+/*
+* Implementation of a contraction hierarchy. While the hierarchy is built
+* every node has a list of out-arcs and a list of in-arcs, and each arc is
+* kept once per pair of nodes with the lowest weight seen. When a node is
+* contracted its arcs are removed from the lists of its neighbours, so
+* the lists only hold the remaining graph, but the node keeps its own
+* lists. Those lead to nodes of higher rank, so when all nodes are
+* contracted they are the upward and downward graphs, which are stored as
+* offset arrays like the frozen graphs of csr.c. Contraction stops early
+* if the remaining graph gets dense, since witness searches there are
+* slow and most neighbours would need shortcuts anyway. The nodes left
+* form a core of equal top rank whose arcs go both ways. A shortcut
+* remembers the node it bypasses, so a route can be unpacked into the
+* edges of the graph.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-07-11: v1.0, first public version.
+*   2022-07-14: v1.1, hierarchy files hold the fingerprint of their map.
+*/
+
+// First word of a hierarchy file.
+#define CH_MAGIC 0x32494843
+// Middle node of an arc that is an edge of the graph, not a shortcut.
+#define NONE UINT32_MAX
+// Largest number of nodes settled by a witness search.
+#define WITNESS_SETTLE 500
+// Contraction stops when the remaining nodes have more out-arcs than
+// this on average.
+#define CORE_DEGREE 32
+// Directions of a query.
+#define FORWARD 0
+#define BACKWARD 1
+
+/*Defines an arc. node is the other end, and mid is the node a shortcut
+bypasses, or NONE */
+typedef struct arc
+{
+        uint32_t node;
+        uint32_t mid;
+        double weight;
+} arc;
+/*Defines one graph of the hierarchy. The arcs of node v are
+arcs[offsets[v]..offsets[v+1]) */
+typedef struct arc_graph
+{
+        uint32_t *offsets;
+        arc *arcs;
+} arc_graph;
+/*Defines the hierarchy. The upward graph holds the arcs from v to nodes
+of higher rank, and the downward graph holds the arcs from nodes of
+higher rank to v, with node set to the node of higher rank */
+struct ch_index
+{
+        uint32_t n;
+        arc_graph up;
+        arc_graph down;
+};
+/*Defines a growable list of arcs */
+typedef struct arc_list
+{
+        arc *arcs;
+        uint32_t count;
+        uint32_t size;
+} arc_list;
+/*Defines a shortcut that the contraction of a node needs */
+typedef struct shortcut
+{
+        uint32_t from;
+        uint32_t to;
+        double weight;
+} shortcut;
+/*Defines the state while the hierarchy is built. dist, touched, target
+and witness are the scratch space of the witness searches, shortcuts
+holds the shortcuts found for the node whose priority was computed last,
+and arcs counts the arcs between nodes not yet contracted */
+typedef struct builder
+{
+        uint32_t n;
+        arc_list *out;
+        arc_list *in;
+        uint32_t *deleted;
+        double *dist;
+        uint32_t *touched;
+        bool *target;
+        heap *witness;
+        shortcut *shortcuts;
+        uint32_t shortcut_count;
+        uint32_t shortcut_size;
+        uint64_t arcs;
+} builder;
+/*Defines one direction of a query */
+typedef struct side
+{
+        double *dist;
+        uint32_t *parent;
+        uint32_t *mid;
+        uint32_t *touched;
+        uint32_t count;
+        heap *frontier;
+} side;
+/*Defines a pending piece of a route while it is unpacked */
+typedef struct piece
+{
+        uint32_t from;
+        uint32_t to;
+        uint32_t mid;
+} piece;
+/*Defines the scratch space for queries. chain holds the nodes of the
+upward part of a route while it is walked back from the meeting node */
+struct ch_search
+{
+        uint32_t n;
+        side sides[2];
+        piece *stack;
+        uint32_t *chain;
+        uint32_t settled;
+};
+/**
+* add_arc() - Add an arc to a list, or lower the weight of an existing
+* arc to the same node.
+* @l: List to manipulate.
+* @node: Other end of the arc.
+* @mid: Bypassed node, or NONE.
+* @weight: Weight of the arc.
+*
+* Returns: True if the arc was added, false if there already was one.
+*/
+static bool add_arc(arc_list *l, uint32_t node, uint32_t mid, double weight)
+{
+        for (uint32_t i = 0; i < l->count; i++)
+        {
+                if (l->arcs[i].node == node)
+                {
+                        if (weight < l->arcs[i].weight)
+                        {
+                                l->arcs[i].weight = weight;
+                                l->arcs[i].mid = mid;
+                        }
+                        return false;
+                }
+        }
+        if (l->count == l->size)
+        {
+                l->size = l->size > 0 ? 2 * l->size : 4;
+                l->arcs = realloc(l->arcs, l->size * sizeof(*l->arcs));
+        }
+        arc a = { node, mid, weight };
+        l->arcs[l->count++] = a;
+        return true;
+}
+/**
+* remove_arc() - Remove the arc to a node from a list.
+* @l: List to manipulate.
+* @node: Other end of the arc.
+*
+* The last arc is moved into the hole, so the order is not kept.
+*
+* Returns: Nothing.
+*/
+static void remove_arc(arc_list *l, uint32_t node)
+{
+        for (uint32_t i = 0; i < l->count; i++)
+        {
+                if (l->arcs[i].node == node)
+                {
+                        l->arcs[i] = l->arcs[--l->count];
+                        return;
+                }
+        }
+}
+/**
+* add_edge() - Add an edge or a shortcut to the hierarchy being built.
+* @b: Builder to manipulate.
+* @from: Source node id.
+* @to: Destination node id.
+* @weight: Weight of the edge.
+* @mid: Bypassed node, or NONE.
+*
+* Returns: Nothing.
+*/
+static void add_edge(builder *b, uint32_t from, uint32_t to, double weight, uint32_t mid)
+{
+        b->arcs += add_arc(&b->out[from], to, mid, weight);
+        add_arc(&b->in[to], from, mid, weight);
+}
+/**
+* witness_search() - Find the costs of paths from a node that avoid
+* another node.
+* @b: Builder whose dist array is set for the nodes reached.
+* @src: Origin node id.
+* @skip: Node id to avoid, the one being contracted.
+* @limit: Largest cost of interest.
+* @targets: Number of nodes other than src marked in b->target.
+*
+* The search stops when all targets are settled, at limit, or after
+* WITNESS_SETTLE settled nodes. Each finite dist is the cost of a real
+* path, so a missed witness only gives an extra shortcut. The touched
+* nodes must be reset by the caller.
+*
+* Returns: The number of touched nodes, stored in b->touched.
+*/
+static uint32_t witness_search(builder *b, uint32_t src, uint32_t skip, double limit,
+                               uint32_t targets)
+{
+        uint32_t count = 0;
+        uint32_t settled = 0;
+        b->dist[src] = 0;
+        b->touched[count++] = src;
+        heap_insert(b->witness, src, 0);
+        while (!heap_is_empty(b->witness) && heap_min_key(b->witness) <= limit
+               && settled++ < WITNESS_SETTLE)
+        {
+                uint32_t v = heap_pop_min(b->witness);
+                if (b->target[v] && v != src && --targets == 0)
+                {
+                        break;
+                }
+                const arc_list *l = &b->out[v];
+                for (uint32_t i = 0; i < l->count; i++)
+                {
+                        uint32_t w = l->arcs[i].node;
+                        if (w == skip)
+                        {
+                                continue;
+                        }
+                        double d = b->dist[v] + l->arcs[i].weight;
+                        if (isinf(b->dist[w]))
+                        {
+                                b->dist[w] = d;
+                                b->touched[count++] = w;
+                                heap_insert(b->witness, w, d);
+                        }
+                        else if (d < b->dist[w] && heap_contains(b->witness, w))
+                        {
+                                b->dist[w] = d;
+                                heap_decrease_key(b->witness, w, d);
+                        }
+                }
+        }
+        heap_clear(b->witness);
+        return count;
+}
+/**
+* find_shortcuts() - Find the shortcuts needed to contract a node.
+* @b: Builder whose shortcuts are set by the call.
+* @v: Node id to contract.
+*
+* For every in-neighbour u and out-neighbour w of v, a shortcut from u to
+* w is needed unless a witness search from u finds a path to w without v
+* that costs no more.
+*
+* Returns: Nothing.
+*/
+static void find_shortcuts(builder *b, uint32_t v)
+{
+        b->shortcut_count = 0;
+        const arc_list *in = &b->in[v];
+        const arc_list *out = &b->out[v];
+        for (uint32_t j = 0; j < out->count; j++)
+        {
+                b->target[out->arcs[j].node] = true;
+        }
+        for (uint32_t i = 0; i < in->count; i++)
+        {
+                uint32_t u = in->arcs[i].node;
+                double limit = -1;
+                uint32_t targets = 0;
+                for (uint32_t j = 0; j < out->count; j++)
+                {
+                        uint32_t w = out->arcs[j].node;
+                        double d = in->arcs[i].weight + out->arcs[j].weight;
+                        if (w != u)
+                        {
+                                targets++;
+                                limit = d > limit ? d : limit;
+                        }
+                }
+                if (targets == 0)
+                {
+                        continue;
+                }
+                uint32_t touched = witness_search(b, u, v, limit, targets);
+                for (uint32_t j = 0; j < out->count; j++)
+                {
+                        uint32_t w = out->arcs[j].node;
+                        double d = in->arcs[i].weight + out->arcs[j].weight;
+                        if (w != u && b->dist[w] > d)
+                        {
+                                if (b->shortcut_count == b->shortcut_size)
+                                {
+                                        b->shortcut_size = b->shortcut_size > 0 ? 2 * b->shortcut_size : 16;
+                                        b->shortcuts = realloc(b->shortcuts,
+                                                b->shortcut_size * sizeof(*b->shortcuts));
+                                }
+                                shortcut sc = { u, w, d };
+                                b->shortcuts[b->shortcut_count++] = sc;
+                        }
+                }
+                for (uint32_t j = 0; j < touched; j++)
+                {
+                        b->dist[b->touched[j]] = INFINITY;
+                }
+        }
+        for (uint32_t j = 0; j < out->count; j++)
+        {
+                b->target[out->arcs[j].node] = false;
+        }
+}
+/**
+* priority() - Compute the contraction priority of a node.
+* @b: Builder to inspect.
+* @v: Node id.
+*
+* The shortcuts needed to contract v are left in b->shortcuts.
+*
+* Returns: The edge difference plus the number of contracted neighbours.
+* A lower value means that v is contracted earlier.
+*/
+static double priority(builder *b, uint32_t v)
+{
+        find_shortcuts(b, v);
+        double removed = b->in[v].count + b->out[v].count;
+        return (double)b->shortcut_count - removed + b->deleted[v];
+}
+/**
+* pack_arcs() - Store the arc lists of all nodes as an arc graph.
+* @lists: Arc lists of all nodes.
+* @n: Number of nodes.
+*
+* Returns: The arc graph.
+*/
+static arc_graph pack_arcs(const arc_list *lists, uint32_t n)
+{
+        arc_graph a;
+        a.offsets = malloc(((size_t)n + 1) * sizeof(*a.offsets));
+        a.offsets[0] = 0;
+        for (uint32_t v = 0; v < n; v++)
+        {
+                a.offsets[v + 1] = a.offsets[v] + lists[v].count;
+        }
+        a.arcs = malloc(((size_t)a.offsets[n] + 1) * sizeof(*a.arcs));
+        for (uint32_t v = 0; v < n; v++)
+        {
+                if (lists[v].count > 0)
+                {
+                        memcpy(&a.arcs[a.offsets[v]], lists[v].arcs,
+                               lists[v].count * sizeof(*a.arcs));
+                }
+        }
+        return a;
+}
+/**
+* graph_contract() - Build a contraction hierarchy of a graph.
+* @g: Graph whose edge weights are all non-negative.
+*
+* Returns: A pointer to the hierarchy.
+*/
+ch_index *graph_contract(const graph *g)
+{
+        builder b;
+        uint32_t n = graph_node_count(g);
+        b.n = n;
+        b.out = calloc(n + 1, sizeof(*b.out));
+        b.in = calloc(n + 1, sizeof(*b.in));
+        b.deleted = calloc(n + 1, sizeof(*b.deleted));
+        b.dist = malloc((n + 1) * sizeof(*b.dist));
+        b.touched = malloc((n + 1) * sizeof(*b.touched));
+        b.target = calloc(n + 1, sizeof(*b.target));
+        b.witness = heap_empty(n);
+        b.shortcuts = NULL;
+        b.shortcut_count = 0;
+        b.shortcut_size = 0;
+        b.arcs = 0;
+        for (uint32_t v = 0; v < n; v++)
+        {
+                b.dist[v] = INFINITY;
+                node *from = graph_node_by_id(g, v);
+                graph_pos p = graph_neighbour_first(g, from);
+                for (; !graph_neighbour_is_end(g, p); p = graph_neighbour_next(g, p))
+                {
+                        uint32_t w = graph_node_id(g, graph_neighbour_inspect(g, p));
+                        //A loop is never part of a cheapest route
+                        if (w != v)
+                        {
+                                add_edge(&b, v, w, graph_neighbour_weight(g, p), NONE);
+                        }
+                }
+        }
+        heap *order = heap_empty(n);
+        for (uint32_t v = 0; v < n; v++)
+        {
+                heap_insert(order, v, priority(&b, v));
+        }
+        uint32_t remaining = n;
+        //The nodes left when the remaining graph gets dense form the core
+        while (!heap_is_empty(order) && b.arcs <= (uint64_t)CORE_DEGREE * remaining)
+        {
+                uint32_t v = heap_pop_min(order);
+                double p = priority(&b, v);
+                if (!heap_is_empty(order) && p > heap_min_key(order))
+                {       //The priority went up since it was queued
+                        heap_insert(order, v, p);
+                        continue;
+                }
+                //Contracts v with the shortcuts its priority was computed from
+                for (uint32_t i = 0; i < b.shortcut_count; i++)
+                {
+                        shortcut *c = &b.shortcuts[i];
+                        add_edge(&b, c->from, c->to, c->weight, v);
+                }
+                b.arcs -= b.in[v].count + b.out[v].count;
+                remaining--;
+                for (uint32_t i = 0; i < b.in[v].count; i++)
+                {
+                        uint32_t u = b.in[v].arcs[i].node;
+                        remove_arc(&b.out[u], v);
+                        b.deleted[u]++;
+                }
+                for (uint32_t i = 0; i < b.out[v].count; i++)
+                {
+                        uint32_t w = b.out[v].arcs[i].node;
+                        remove_arc(&b.in[w], v);
+                        b.deleted[w]++;
+                }
+        }
+        ch_index *h = malloc(sizeof(*h));
+        h->n = n;
+        //The arcs left in the lists of a node lead to nodes contracted later
+        h->up = pack_arcs(b.out, n);
+        h->down = pack_arcs(b.in, n);
+
+        for (uint32_t v = 0; v < n; v++)
+        {
+                free(b.out[v].arcs);
+                free(b.in[v].arcs);
+        }
+        free(b.out);
+        free(b.in);
+        free(b.deleted);
+        free(b.dist);
+        free(b.touched);
+        free(b.target);
+        free(b.shortcuts);
+        heap_kill(b.witness);
+        heap_kill(order);
+        return h;
+}
+/**
+* ch_search_empty() - Create the scratch space for queries.
+* @h: Hierarchy to query.
+*
+* Returns: A pointer to the scratch space.
+*/
+ch_search *ch_search_empty(const ch_index *h)
+{
+        ch_search *s = malloc(sizeof(*s));
+        uint32_t n = h->n;
+        s->n = n;
+        for (int d = 0; d < 2; d++)
+        {
+                side *sd = &s->sides[d];
+                sd->dist = malloc((n + 1) * sizeof(*sd->dist));
+                sd->parent = malloc((n + 1) * sizeof(*sd->parent));
+                sd->mid = malloc((n + 1) * sizeof(*sd->mid));
+                sd->touched = malloc((n + 1) * sizeof(*sd->touched));
+                sd->count = 0;
+                sd->frontier = heap_empty(n);
+                for (uint32_t v = 0; v < n; v++)
+                {
+                        sd->dist[v] = INFINITY;
+                }
+        }
+        s->stack = malloc((n + 1) * sizeof(*s->stack));
+        s->chain = malloc((n + 1) * sizeof(*s->chain));
+        s->settled = 0;
+        return s;
+}
+/**
+* find_arc() - Find the arc between two nodes.
+* @a: Arc graph to search.
+* @v: Node whose arcs are searched.
+* @node: Other end of the arc.
+*
+* Returns: A pointer to the arc.
+*/
+static const arc *find_arc(const arc_graph *a, uint32_t v, uint32_t node)
+{
+        for (uint32_t i = a->offsets[v]; i < a->offsets[v + 1]; i++)
+        {
+                if (a->arcs[i].node == node)
+                {
+                        return &a->arcs[i];
+                }
+        }
+        return NULL;
+}
+/**
+* unpack() - Append the edges of the graph that an arc stands for to a
+* route.
+* @h: Hierarchy the arc is from.
+* @s: Scratch space, whose stack is used.
+* @from: Source node id of the arc.
+* @to: Destination node id of the arc.
+* @mid: Node bypassed by the arc, or NONE.
+* @route: Route to append to.
+* @hops: Number of hops in the route, updated by the call.
+*
+* A shortcut from u to w through v stands for the arc from u to v, which
+* is in the downward graph of v, and the arc from v to w, which is in its
+* upward graph. The pieces are kept on a stack instead of recursing.
+*
+* Returns: Nothing.
+*/
+static void unpack(const ch_index *h, ch_search *s, uint32_t from, uint32_t to,
+                   uint32_t mid, uint32_t *route, int *hops)
+{
+        uint32_t top = 0;
+        piece first = { from, to, mid };
+        s->stack[top++] = first;
+        while (top > 0)
+        {
+                piece p = s->stack[--top];
+                if (p.mid == NONE)
+                {
+                        route[++*hops] = p.to;
+                        continue;
+                }
+                //The second half goes first on the stack, so it comes out last
+                piece second = { p.mid, p.to, find_arc(&h->up, p.mid, p.to)->mid };
+                piece first = { p.from, p.mid, find_arc(&h->down, p.mid, p.from)->mid };
+                s->stack[top++] = second;
+                s->stack[top++] = first;
+        }
+}
+/**
+* ch_route() - Find a cheapest route between two nodes.
+* @h: Hierarchy to query.
+* @s: Scratch space created for h.
+* @src: Id of the origin node.
+* @dest: Id of the destination node.
+* @cost: Set to the total weight of the route, if there is one.
+* @route: Room for all nodes of the graph.
+*
+* The two directions take turns to settle a node. A direction stops when
+* its smallest key is no lower than the cheapest route found, since every
+* route it could still find costs at least that much.
+*
+* Returns: The number of hops of the route, or -1 if there is no path.
+*/
+int ch_route(const ch_index *h, ch_search *s, uint32_t src, uint32_t dest,
+             double *cost, uint32_t *route)
+{
+        const arc_graph *graphs[2] = { &h->up, &h->down };
+        uint32_t ends[2] = { src, dest };
+        for (int d = 0; d < 2; d++)
+        {
+                side *sd = &s->sides[d];
+                sd->dist[ends[d]] = 0;
+                sd->parent[ends[d]] = ends[d];
+                sd->mid[ends[d]] = NONE;
+                sd->touched[sd->count++] = ends[d];
+                heap_insert(sd->frontier, ends[d], 0);
+        }
+        double best = INFINITY;
+        uint32_t meet = NONE;
+        s->settled = 0;
+        int turn = FORWARD;
+        while (!heap_is_empty(s->sides[FORWARD].frontier)
+               || !heap_is_empty(s->sides[BACKWARD].frontier))
+        {
+                if (heap_is_empty(s->sides[turn].frontier))
+                {
+                        turn = 1 - turn;
+                }
+                side *sd = &s->sides[turn];
+                const side *other = &s->sides[1 - turn];
+                if (heap_min_key(sd->frontier) >= best)
+                {       //This direction can not find a cheaper route
+                        heap_clear(sd->frontier);
+                        continue;
+                }
+                uint32_t v = heap_pop_min(sd->frontier);
+                s->settled++;
+                if (sd->dist[v] + other->dist[v] < best)
+                {
+                        best = sd->dist[v] + other->dist[v];
+                        meet = v;
+                }
+                const arc_graph *a = graphs[turn];
+                for (uint32_t i = a->offsets[v]; i < a->offsets[v + 1]; i++)
+                {
+                        uint32_t w = a->arcs[i].node;
+                        double d = sd->dist[v] + a->arcs[i].weight;
+                        if (isinf(sd->dist[w]))
+                        {
+                                sd->touched[sd->count++] = w;
+                                heap_insert(sd->frontier, w, d);
+                        }
+                        else if (d < sd->dist[w] && heap_contains(sd->frontier, w))
+                        {
+                                heap_decrease_key(sd->frontier, w, d);
+                        }
+                        else
+                        {
+                                continue;
+                        }
+                        sd->dist[w] = d;
+                        sd->parent[w] = v;
+                        sd->mid[w] = a->arcs[i].mid;
+                }
+                turn = 1 - turn;
+        }
+        int hops = -1;
+        if (meet != NONE)
+        {       //Walks back from the meeting node to src, then unpacks forwards
+                const side *f = &s->sides[FORWARD];
+                const side *r = &s->sides[BACKWARD];
+                uint32_t count = 0;
+                for (uint32_t v = meet; v != src; v = f->parent[v])
+                {
+                        s->chain[count++] = v;
+                }
+                hops = 0;
+                route[0] = src;
+                while (count > 0)
+                {
+                        uint32_t v = s->chain[--count];
+                        unpack(h, s, f->parent[v], v, f->mid[v], route, &hops);
+                }
+                for (uint32_t v = meet; v != dest; v = r->parent[v])
+                {
+                        unpack(h, s, v, r->parent[v], r->mid[v], route, &hops);
+                }
+                *cost = best;
+        }
+        for (int d = 0; d < 2; d++)
+        {
+                side *sd = &s->sides[d];
+                for (uint32_t i = 0; i < sd->count; i++)
+                {
+                        sd->dist[sd->touched[i]] = INFINITY;
+                }
+                sd->count = 0;
+        }
+        return hops;
+}
+/**
+* ch_search_settled() - Return the number of nodes settled by the last
+* query.
+* @s: Scratch space of the query.
+*
+* Returns: The number of nodes settled by both directions together.
+*/
+uint32_t ch_search_settled(const ch_search *s)
+{
+        return s->settled;
+}
+/**
+* ch_search_kill() - Destroy the scratch space for queries.
+* @s: Scratch space to destroy.
+*
+* Returns: Nothing.
+*/
+void ch_search_kill(ch_search *s)
+{
+        for (int d = 0; d < 2; d++)
+        {
+                free(s->sides[d].dist);
+                free(s->sides[d].parent);
+                free(s->sides[d].mid);
+                free(s->sides[d].touched);
+                heap_kill(s->sides[d].frontier);
+        }
+        free(s->stack);
+        free(s->chain);
+        free(s);
+}
+/**
+* write_arcs() - Write an arc graph to a file.
+* @a: Arc graph to write.
+* @n: Number of nodes.
+* @out: File to write to.
+*
+* Returns: True if the arc graph was written, otherwise false.
+*/
+static bool write_arcs(const arc_graph *a, uint32_t n, FILE *out)
+{
+        return fwrite(a->offsets, sizeof(*a->offsets), n + 1, out) == n + 1
+                && fwrite(a->arcs, sizeof(*a->arcs), a->offsets[n], out) == a->offsets[n];
+}
+/**
+* ch_save() - Write a hierarchy to a file.
+* @h: Hierarchy to write.
+* @file: Name of the file.
+* @fingerprint: Fingerprint of the map the hierarchy was built from.
+*
+* The file holds a header of six words (magic number, nodes, upward
+* arcs, downward arcs and the two halves of the fingerprint) followed by
+* the offsets and arcs of the upward and then the downward graph.
+*
+* Returns: True if the hierarchy was written, otherwise false.
+*/
+bool ch_save(const ch_index *h, const char *file, uint64_t fingerprint)
+{
+        FILE *out = fopen(file, "wb");
+        if (out == NULL)
+        {
+                return false;
+        }
+        uint32_t header[6] = { CH_MAGIC, h->n, h->up.offsets[h->n], h->down.offsets[h->n],
+                               (uint32_t)fingerprint, (uint32_t)(fingerprint >> 32) };
+        bool ok = fwrite(header, sizeof(uint32_t), 6, out) == 6
+                && write_arcs(&h->up, h->n, out)
+                && write_arcs(&h->down, h->n, out);
+        return fclose(out) == 0 && ok;
+}
+/**
+* read_arcs() - Read an arc graph from a file.
+* @in: File to read from.
+* @n: Number of nodes.
+* @count: Number of arcs.
+* @a: Set to the arc graph. Its arrays are NULL if they could not be
+* read.
+*
+* Returns: True if the arc graph was read and is consistent, otherwise
+* false.
+*/
+static bool read_arcs(FILE *in, uint32_t n, uint32_t count, arc_graph *a)
+{
+        a->offsets = malloc(((size_t)n + 1) * sizeof(*a->offsets));
+        a->arcs = malloc(((size_t)count + 1) * sizeof(*a->arcs));
+        if (fread(a->offsets, sizeof(*a->offsets), n + 1, in) != n + 1
+            || fread(a->arcs, sizeof(*a->arcs), count, in) != count
+            || a->offsets[0] != 0 || a->offsets[n] != count)
+        {
+                return false;
+        }
+        //Ids or offsets out of range would make queries read outside the arrays
+        for (uint32_t v = 0; v < n; v++)
+        {
+                if (a->offsets[v] > a->offsets[v + 1])
+                {
+                        return false;
+                }
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+                if (a->arcs[i].node >= n || (a->arcs[i].mid != NONE && a->arcs[i].mid >= n)
+                    || !(a->arcs[i].weight >= 0))
+                {
+                        return false;
+                }
+        }
+        return true;
+}
+/**
+* ch_load() - Read a hierarchy from a file.
+* @file: Name of the file.
+* @n: Number of nodes of the graph the hierarchy is for.
+* @fingerprint: Fingerprint of the map the graph was read from.
+*
+* Returns: A pointer to the hierarchy, or NULL if the file can not be
+* read or does not hold a hierarchy for a graph with n nodes read from a
+* map with the same fingerprint.
+*/
+ch_index *ch_load(const char *file, uint32_t n, uint64_t fingerprint)
+{
+        FILE *in = fopen(file, "rb");
+        if (in == NULL)
+        {
+                return NULL;
+        }
+        uint32_t header[6];
+        if (fread(header, sizeof(uint32_t), 6, in) != 6 || header[0] != CH_MAGIC
+            || header[1] != n || header[4] != (uint32_t)fingerprint
+            || header[5] != (uint32_t)(fingerprint >> 32))
+        {
+                fclose(in);
+                return NULL;
+        }
+        ch_index *h = calloc(1, sizeof(*h));
+        h->n = n;
+        bool ok = read_arcs(in, n, header[2], &h->up)
+                && read_arcs(in, n, header[3], &h->down);
+        fclose(in);
+        if (!ok)
+        {
+                ch_kill(h);
+                return NULL;
+        }
+        return h;
+}
+/**
+* ch_kill() - Destroy a contraction hierarchy.
+* @h: Hierarchy to destroy.
+*
+* Returns: Nothing.
+*/
+void ch_kill(ch_index *h)
+{
+        free(h->up.offsets);
+        free(h->up.arcs);
+        free(h->down.offsets);
+        free(h->down.arcs);
+        free(h);
+}
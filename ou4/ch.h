@@ -0,0 +1,130 @@
+#ifndef __CH_H
+#define __CH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+
+/*
+ * Declaration of a contraction hierarchy over the weighted edges of a
+ * graph. The nodes are contracted one at a time, least important first,
+ * and when a node is removed a shortcut edge is inserted between two of
+ * its neighbours unless they are joined by another path that is no more
+ * expensive. The rank of a node is the order in which it was contracted.
+ * The upward graph holds the edges to nodes of higher rank, and the
+ * downward graph holds the edges from nodes of higher rank, reversed. A
+ * cheapest route then always goes up from the origin and down to the
+ * destination, so a query is a Dijkstra search up from both ends, which
+ * settles few nodes. If the graph left during contraction becomes dense,
+ * the remaining nodes are kept as an uncontracted core at the top, which
+ * both searches simply pass through. A hierarchy can be saved to a file
+ * and loaded again.
+ * After use, the function ch_kill() must be called to de-allocate its
+ * dynamic memory.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-07-11: v1.0, first public version.
+ *   2022-07-14: v1.1, hierarchy files hold the fingerprint of their map.
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct ch_index ch_index;
+
+// Scratch space for queries, kept apart from the hierarchy itself.
+typedef struct ch_search ch_search;
+
+// =================== CONTRACTION HIERARCHY INTERFACE ======================
+
+/**
+ * graph_contract() - Build a contraction hierarchy of a graph.
+ * @g: Graph whose edge weights are all non-negative.
+ *
+ * The next node to contract is the one with the lowest edge difference
+ * (shortcuts added minus edges removed) plus number of contracted
+ * neighbours. The priorities are updated lazily: a node is taken from
+ * the queue, its priority is computed again, and it is put back if it is
+ * no longer the lowest. Witness searches are limited, so a few more
+ * shortcuts than needed may be inserted, but never too few.
+ *
+ * Returns: A pointer to the hierarchy.
+ */
+ch_index *graph_contract(const graph *g);
+
+/**
+ * ch_search_empty() - Create the scratch space for queries.
+ * @h: Hierarchy to query.
+ *
+ * Returns: A pointer to the scratch space.
+ */
+ch_search *ch_search_empty(const ch_index *h);
+
+/**
+ * ch_route() - Find a cheapest route between two nodes.
+ * @h: Hierarchy to query.
+ * @s: Scratch space created for h.
+ * @src: Id of the origin node.
+ * @dest: Id of the destination node.
+ * @cost: Set to the total weight of the route, if there is one.
+ * @route: Room for all nodes of the graph. The ids of the nodes of the
+ *         route are stored here, with src first and dest last.
+ *
+ * The shortcuts of the route are replaced by the edges they stand for,
+ * so the route is one of the graph the hierarchy was built from.
+ *
+ * Returns: The number of hops of the route, or -1 if there is no path.
+ */
+int ch_route(const ch_index *h, ch_search *s, uint32_t src, uint32_t dest,
+             double *cost, uint32_t *route);
+
+/**
+ * ch_search_settled() - Return the number of nodes settled by the last
+ * query.
+ * @s: Scratch space of the query.
+ *
+ * Returns: The number of nodes settled by both directions together.
+ */
+uint32_t ch_search_settled(const ch_search *s);
+
+/**
+ * ch_search_kill() - Destroy the scratch space for queries.
+ * @s: Scratch space to destroy.
+ *
+ * Returns: Nothing.
+ */
+void ch_search_kill(ch_search *s);
+
+/**
+ * ch_save() - Write a hierarchy to a file.
+ * @h: Hierarchy to write.
+ * @file: Name of the file.
+ * @fingerprint: Fingerprint of the map the hierarchy was built from.
+ *
+ * Returns: True if the hierarchy was written, otherwise false.
+ */
+bool ch_save(const ch_index *h, const char *file, uint64_t fingerprint);
+
+/**
+ * ch_load() - Read a hierarchy from a file.
+ * @file: Name of the file.
+ * @n: Number of nodes of the graph the hierarchy is for.
+ * @fingerprint: Fingerprint of the map the graph was read from.
+ *
+ * Returns: A pointer to the hierarchy, or NULL if the file can not be
+ * read or does not hold a hierarchy for a graph with n nodes read from a
+ * map with the same fingerprint.
+ */
+ch_index *ch_load(const char *file, uint32_t n, uint64_t fingerprint);
+
+/**
+ * ch_kill() - Destroy a contraction hierarchy.
+ * @h: Hierarchy to destroy.
+ *
+ * Returns: Nothing.
+ */
+void ch_kill(ch_index *h);
+
+#endif
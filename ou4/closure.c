@@ -0,0 +1,230 @@
+#define _POSIX_C_SOURCE 200112L
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "csr.h"
+#include "scc.h"
+#include "bitset.h"
+#include "closure.h"
+
+/*
+* Implementation of a transitive closure index over the condensation of a
+* graph. The components are grouped into levels, where the level of a
+* component is one more than the highest level of its successors. The
+* rows of one level only depend on rows of lower levels, so worker threads
+* compute a level at a time and meet at a barrier between levels.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-06-30: v1.0, first public version.
+*/
+
+/*Defines the index. Row c holds words bitset words */
+struct closure
+{
+        const uint32_t *component;
+        uint32_t components;
+        int words;
+        uint64_t *rows;
+};
+/*Defines the work shared by the threads building an index */
+typedef struct build_work
+{
+        closure *c;
+        const csr_graph *dag;
+        //Components sorted by level, level l is order[start[l]..start[l+1])
+        uint32_t *order;
+        uint32_t *start;
+        uint32_t levels;
+        int threads;
+        pthread_barrier_t barrier;
+} build_work;
+/*Defines the arguments of one thread */
+typedef struct build_thread
+{
+        build_work *work;
+        int id;
+} build_thread;
+/**
+* row() - Return the row of a component.
+* @c: Index to inspect.
+* @comp: Component id.
+*
+* Returns: A pointer to the first word of the row.
+*/
+static uint64_t *row(const closure *c, uint32_t comp)
+{
+        return c->rows + (size_t)comp * c->words;
+}
+/**
+* build_row() - Compute the row of a component.
+* @c: Index to manipulate.
+* @dag: Condensation the index is built from.
+* @comp: Component id.
+*
+* Successors have lower ids than comp, so only the words up to the one
+* holding bit comp can be non-zero and have to be combined.
+*
+* Returns: Nothing.
+*/
+static void build_row(closure *c, const csr_graph *dag, uint32_t comp)
+{
+        uint64_t *r = row(c, comp);
+        int words = bitset_words(comp + 1);
+        bitset_set(r, comp);
+        for (uint32_t k = dag->offsets[comp]; k < dag->offsets[comp + 1]; k++)
+        {
+                bitset_or(r, row(c, dag->targets[k]), words);
+        }
+}
+/**
+* build_levels() - Compute the rows of every thread:th component per level.
+* @arg: Pointer to the build_thread of the thread.
+*
+* Returns: NULL.
+*/
+static void *build_levels(void *arg)
+{
+        build_thread *t = arg;
+        build_work *w = t->work;
+        for (uint32_t l = 0; l < w->levels; l++)
+        {
+                for (uint32_t k = w->start[l] + t->id; k < w->start[l + 1];
+                     k += w->threads)
+                {
+                        build_row(w->c, w->dag, w->order[k]);
+                }
+                //The next level reads the rows of this one
+                pthread_barrier_wait(&w->barrier);
+        }
+        return NULL;
+}
+/**
+* sort_by_level() - Sort the components by level.
+* @dag: Condensation to inspect.
+* @w: Work to fill in the order, start and levels of.
+*
+* Returns: Nothing.
+*/
+static void sort_by_level(const csr_graph *dag, build_work *w)
+{
+        uint32_t *level = malloc((dag->n + 1) * sizeof(*level));
+        w->levels = 0;
+        //Successors have lower ids, so their levels are known
+        for (uint32_t comp = 0; comp < dag->n; comp++)
+        {
+                level[comp] = 0;
+                for (uint32_t k = dag->offsets[comp]; k < dag->offsets[comp + 1]; k++)
+                {
+                        if (level[dag->targets[k]] + 1 > level[comp])
+                        {
+                                level[comp] = level[dag->targets[k]] + 1;
+                        }
+                }
+                if (level[comp] + 1 > w->levels)
+                {
+                        w->levels = level[comp] + 1;
+                }
+        }
+        //Counting sort of the components by level
+        w->start = calloc(w->levels + 2, sizeof(*w->start));
+        w->order = malloc((dag->n + 1) * sizeof(*w->order));
+        for (uint32_t comp = 0; comp < dag->n; comp++)
+        {
+                w->start[level[comp] + 2]++;
+        }
+        for (uint32_t l = 0; l < w->levels; l++)
+        {
+                w->start[l + 2] += w->start[l + 1];
+        }
+        for (uint32_t comp = 0; comp < dag->n; comp++)
+        {
+                w->order[w->start[level[comp] + 1]++] = comp;
+        }
+        free(level);
+}
+/**
+* scc_closure() - Build the transitive closure of a condensation.
+* @s: Components and condensation of a graph.
+* @threads: Number of threads to use, or 0 for one per online processor.
+*
+* Returns: A pointer to the index.
+*/
+closure *scc_closure(const scc_graph *s, int threads)
+{
+        closure *c = malloc(sizeof(*c));
+        c->component = s->component;
+        c->components = s->components;
+        c->words = bitset_words(s->components);
+        c->rows = calloc((size_t)s->components * c->words + 1, sizeof(*c->rows));
+        if (threads <= 0)
+        {
+                threads = sysconf(_SC_NPROCESSORS_ONLN);
+        }
+        if (threads <= 1)
+        {
+                //Ids are already in reverse topological order
+                for (uint32_t comp = 0; comp < s->components; comp++)
+                {
+                        build_row(c, s->dag, comp);
+                }
+                return c;
+        }
+        build_work w;
+        w.c = c;
+        w.dag = s->dag;
+        w.threads = threads;
+        sort_by_level(s->dag, &w);
+        pthread_barrier_init(&w.barrier, NULL, threads);
+        pthread_t *ids = malloc(threads * sizeof(*ids));
+        build_thread *args = malloc(threads * sizeof(*args));
+        for (int i = 0; i < threads; i++)
+        {
+                args[i].work = &w;
+                args[i].id = i;
+        }
+        //The calling thread works as thread 0
+        for (int i = 1; i < threads; i++)
+        {
+                pthread_create(&ids[i], NULL, build_levels, &args[i]);
+        }
+        build_levels(&args[0]);
+        for (int i = 1; i < threads; i++)
+        {
+                pthread_join(ids[i], NULL);
+        }
+        pthread_barrier_destroy(&w.barrier);
+        free(ids);
+        free(args);
+        free(w.order);
+        free(w.start);
+        return c;
+}
+/**
+* closure_path_exists() - Check if there is a path between two nodes.
+* @c: Index to inspect.
+* @src: Id of the origin node.
+* @dest: Id of the destination node.
+*
+* Returns: True if dest can be reached from src, otherwise false.
+*/
+bool closure_path_exists(const closure *c, uint32_t src, uint32_t dest)
+{
+        return bitset_test(row(c, c->component[src]), c->component[dest]);
+}
+/**
+* closure_kill() - Destroy a transitive closure index.
+* @c: Index to destroy.
+*
+* Returns: Nothing.
+*/
+void closure_kill(closure *c)
+{
+        free(c->rows);
+        free(c);
+}
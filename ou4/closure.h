@@ -0,0 +1,64 @@
+#ifndef __CLOSURE_H
+#define __CLOSURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "scc.h"
+
+/*
+ * Declaration of a transitive closure index over the condensation of a
+ * graph (see scc.h). Row c of the index is a bitset over the component
+ * ids of the components that can be reached from component c, so a
+ * query is a single bit test. The index takes C*C/8 bytes for C
+ * components, and is meant for graphs of up to some tens of thousands
+ * of components. The index refers to the component ids of the scc_graph
+ * it was built from, which must not be killed before the index. After
+ * use, the function closure_kill() must be called to de-allocate its
+ * dynamic memory.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-06-30: v1.0, first public version.
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct closure closure;
+
+// =================== CLOSURE INTERFACE ======================
+
+/**
+ * scc_closure() - Build the transitive closure of a condensation.
+ * @s: Components and condensation of a graph.
+ * @threads: Number of threads to use, or 0 for one per online processor.
+ *
+ * The rows are computed in reverse topological order, each as the OR of
+ * the rows of its DAG successors. Components whose successors are all
+ * done form a level, and the rows of a level are split between the
+ * threads.
+ *
+ * Returns: A pointer to the index.
+ */
+closure *scc_closure(const scc_graph *s, int threads);
+
+/**
+ * closure_path_exists() - Check if there is a path between two nodes.
+ * @c: Index to inspect.
+ * @src: Id of the origin node.
+ * @dest: Id of the destination node.
+ *
+ * Returns: True if dest can be reached from src, otherwise false.
+ */
+bool closure_path_exists(const closure *c, uint32_t src, uint32_t dest);
+
+/**
+ * closure_kill() - Destroy a transitive closure index.
+ * @c: Index to destroy.
+ *
+ * Returns: Nothing.
+ */
+void closure_kill(closure *c);
+
+#endif
@@ -0,0 +1,367 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "graph.h"
+#include "csr.h"
+#include "bitset.h"
+
+/*
+* Implementation of an immutable compressed-sparse-row copy of a graph,
+* built with the graph interface so that it works with any graph
+* implementation.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-06-21: v1.0, first public version.
+*   2022-06-25: v1.1, searches keep their visited marks in a csr_search.
+*   2022-07-02: v1.2, added the direction-optimizing search.
+*   2022-07-04: v1.3, added csr_search_from().
+*/
+
+// Go bottom-up when the frontier has more than 1/ALPHA of the edges of
+// the unvisited nodes, and top-down when it has fewer than 1/BETA of the
+// nodes. The values are the ones suggested by Beamer et al.
+#define ALPHA 14
+#define BETA 24
+
+/**
+* graph_freeze() - Create a CSR copy of a graph.
+* @g: Graph to freeze.
+*
+* Returns: A pointer to the frozen graph.
+*/
+csr_graph *graph_freeze(const graph *g)
+{
+        csr_graph *c = malloc(sizeof(*c));
+        c->n = graph_node_count(g);
+        c->offsets = malloc((c->n + 1) * sizeof(*c->offsets));
+        //First pass counts the out-degrees into the offsets
+        c->offsets[0] = 0;
+        for (uint32_t i = 0; i < c->n; i++)
+        {
+                uint32_t degree = 0;
+                graph_pos pos = graph_neighbour_first(g, graph_node_by_id(g, i));
+                while (!graph_neighbour_is_end(g, pos))
+                {
+                        degree++;
+                        pos = graph_neighbour_next(g, pos);
+                }
+                c->offsets[i + 1] = c->offsets[i] + degree;
+        }
+        c->m = c->offsets[c->n];
+        //Second pass stores the target ids
+        c->targets = malloc((c->m > 0 ? c->m : 1) * sizeof(*c->targets));
+        for (uint32_t i = 0; i < c->n; i++)
+        {
+                uint32_t k = c->offsets[i];
+                graph_pos pos = graph_neighbour_first(g, graph_node_by_id(g, i));
+                while (!graph_neighbour_is_end(g, pos))
+                {
+                        c->targets[k++] = graph_node_id(g, graph_neighbour_inspect(g, pos));
+                        pos = graph_neighbour_next(g, pos);
+                }
+        }
+        return c;
+}
+/**
+* csr_transpose() - Create the transpose of a frozen graph.
+* @c: Frozen graph.
+*
+* Returns: A pointer to the transposed graph.
+*/
+csr_graph *csr_transpose(const csr_graph *c)
+{
+        csr_graph *t = malloc(sizeof(*t));
+        t->n = c->n;
+        t->m = c->m;
+        t->offsets = calloc(c->n + 2, sizeof(*t->offsets));
+        t->targets = malloc((c->m > 0 ? c->m : 1) * sizeof(*t->targets));
+        //Counts the in-degrees, shifted one step to get the offsets below
+        for (uint32_t k = 0; k < c->m; k++)
+        {
+                t->offsets[c->targets[k] + 2]++;
+        }
+        for (uint32_t i = 0; i < c->n; i++)
+        {
+                t->offsets[i + 2] += t->offsets[i + 1];
+        }
+        //offsets[j+1] is where the next source of an edge to j goes
+        for (uint32_t i = 0; i < c->n; i++)
+        {
+                for (uint32_t k = c->offsets[i]; k < c->offsets[i + 1]; k++)
+                {
+                        t->targets[t->offsets[c->targets[k] + 1]++] = i;
+                }
+        }
+        return t;
+}
+/**
+* csr_search_empty() - Create scratch space for searches.
+* @c: Frozen graph that will be searched.
+*
+* Returns: A pointer to the scratch space.
+*/
+csr_search *csr_search_empty(const csr_graph *c)
+{
+        csr_search *s = malloc(sizeof(*s));
+        s->n = c->n;
+        s->epoch = 0;
+        s->seen = calloc(c->n + 1, sizeof(*s->seen));
+        s->queue = malloc((c->n + 1) * sizeof(*s->queue));
+        s->frontier = bitset_empty(c->n);
+        s->next = bitset_empty(c->n);
+        return s;
+}
+/**
+* csr_search_begin() - Start a new search, clearing all visited marks.
+* @s: Scratch space to reset.
+*
+* Returns: Nothing.
+*/
+void csr_search_begin(csr_search *s)
+{
+        s->epoch++;
+        if (s->epoch == 0)
+        {
+                //The counter wrapped, so old stamps could match again
+                memset(s->seen, 0, s->n * sizeof(*s->seen));
+                s->epoch = 1;
+        }
+}
+/**
+* csr_search_kill() - Destroy scratch space for searches.
+* @s: Scratch space to destroy.
+*
+* Returns: Nothing.
+*/
+void csr_search_kill(csr_search *s)
+{
+        free(s->seen);
+        free(s->queue);
+        free(s->frontier);
+        free(s->next);
+        free(s);
+}
+/**
+* csr_path_exists() - Check if there is a path between two nodes.
+* @c: Frozen graph to search.
+* @s: Scratch space for the search.
+* @src: Id of the origin node.
+* @dest: Id of the destination node.
+*
+* The queue is a flat array since every node is enqueued at most once.
+*
+* Returns: True if dest can be reached from src, otherwise false.
+*/
+bool csr_path_exists(const csr_graph *c, csr_search *s, uint32_t src,
+                     uint32_t dest)
+{
+        uint32_t *seen = s->seen;
+        uint32_t *queue = s->queue;
+        uint32_t head = 0;
+        uint32_t tail = 0;
+
+        csr_search_begin(s);
+        seen[src] = s->epoch;
+        queue[tail++] = src;
+        while (head < tail)
+        {
+                uint32_t u = queue[head++];
+                if (u == dest)
+                {
+                        return true;
+                }
+                for (uint32_t k = c->offsets[u]; k < c->offsets[u + 1]; k++)
+                {
+                        uint32_t v = c->targets[k];
+                        if (seen[v] != s->epoch)
+                        {
+                                seen[v] = s->epoch;
+                                queue[tail++] = v;
+                        }
+                }
+        }
+        return false;
+}
+/**
+* csr_search_from() - Visit every node that can be reached from a node.
+* @c: Frozen graph to search.
+* @s: Scratch space, where the visited nodes are marked.
+* @src: Id of the origin node.
+*
+* Returns: The number of visited nodes, including src.
+*/
+uint32_t csr_search_from(const csr_graph *c, csr_search *s, uint32_t src)
+{
+        uint32_t *seen = s->seen;
+        uint32_t *queue = s->queue;
+        uint32_t head = 0;
+        uint32_t tail = 0;
+
+        csr_search_begin(s);
+        seen[src] = s->epoch;
+        queue[tail++] = src;
+        while (head < tail)
+        {
+                uint32_t u = queue[head++];
+                for (uint32_t k = c->offsets[u]; k < c->offsets[u + 1]; k++)
+                {
+                        uint32_t v = c->targets[k];
+                        if (seen[v] != s->epoch)
+                        {
+                                seen[v] = s->epoch;
+                                queue[tail++] = v;
+                        }
+                }
+        }
+        return tail;
+}
+/**
+* degree() - Return the out-degree of a node.
+* @c: Frozen graph.
+* @u: Id of the node.
+*
+* Returns: The number of out-edges of u.
+*/
+static uint32_t degree(const csr_graph *c, uint32_t u)
+{
+        return c->offsets[u + 1] - c->offsets[u];
+}
+/**
+* bottom_up_level() - Find the next level by checking every unvisited node.
+* @t: Transposed graph to take the in-edges from.
+* @s: Scratch space with the current level in s->frontier.
+* @c: Frozen graph, for the out-degrees.
+* @edges: Set to the number of out-edges of the next level.
+*
+* The next level is left in s->frontier.
+*
+* Returns: The number of nodes in the next level.
+*/
+static uint32_t bottom_up_level(const csr_graph *c, const csr_graph *t,
+                                csr_search *s, uint64_t *edges)
+{
+        uint32_t count = 0;
+        *edges = 0;
+        bitset_clear(s->next, bitset_words(s->n));
+        for (uint32_t v = 0; v < s->n; v++)
+        {
+                if (s->seen[v] == s->epoch)
+                {
+                        continue;
+                }
+                for (uint32_t k = t->offsets[v]; k < t->offsets[v + 1]; k++)
+                {
+                        if (bitset_test(s->frontier, t->targets[k]))
+                        {     //One parent is enough, the rest are skipped
+                                s->seen[v] = s->epoch;
+                                bitset_set(s->next, v);
+                                count++;
+                                *edges += degree(c, v);
+                                break;
+                        }
+                }
+        }
+        uint64_t *tmp = s->frontier;
+        s->frontier = s->next;
+        s->next = tmp;
+        return count;
+}
+/**
+* csr_path_exists_hybrid() - Check if there is a path, switching direction.
+* @c: Frozen graph to search.
+* @t: Transpose of c.
+* @s: Scratch space for the search.
+* @src: Id of the origin node.
+* @dest: Id of the destination node.
+*
+* A top-down level is queue[head..tail). A bottom-up level is the bitset
+* s->frontier. The level is converted when the direction changes.
+*
+* Returns: True if dest can be reached from src, otherwise false.
+*/
+bool csr_path_exists_hybrid(const csr_graph *c, const csr_graph *t,
+                            csr_search *s, uint32_t src, uint32_t dest)
+{
+        uint32_t *queue = s->queue;
+        uint32_t head = 0;
+        uint32_t tail = 0;
+        bool bottom_up = false;
+        //Out-edges of the current level and of the unvisited nodes
+        uint64_t frontier_edges = degree(c, src);
+        uint64_t unvisited_edges = c->m - frontier_edges;
+        uint32_t frontier_nodes = 1;
+
+        csr_search_begin(s);
+        s->seen[src] = s->epoch;
+        queue[tail++] = src;
+        while (frontier_nodes > 0)
+        {
+                if (s->seen[dest] == s->epoch)
+                {
+                        return true;
+                }
+                if (!bottom_up && frontier_edges > unvisited_edges / ALPHA)
+                {     //Moves the level from the queue to the bitset
+                        bitset_clear(s->frontier, bitset_words(s->n));
+                        for (uint32_t k = head; k < tail; k++)
+                        {
+                                bitset_set(s->frontier, queue[k]);
+                        }
+                        bottom_up = true;
+                }
+                else if (bottom_up && frontier_nodes < s->n / BETA)
+                {     //Moves the level from the bitset to the queue
+                        head = tail = 0;
+                        for (int v = bitset_next(s->frontier, bitset_words(s->n), 0);
+                             v >= 0; v = bitset_next(s->frontier, bitset_words(s->n), v + 1))
+                        {
+                                queue[tail++] = v;
+                        }
+                        bottom_up = false;
+                }
+                if (bottom_up)
+                {
+                        frontier_nodes = bottom_up_level(c, t, s, &frontier_edges);
+                }
+                else
+                {
+                        uint32_t end = tail;
+                        frontier_edges = 0;
+                        for (; head < end; head++)
+                        {
+                                uint32_t u = queue[head];
+                                for (uint32_t k = c->offsets[u]; k < c->offsets[u + 1]; k++)
+                                {
+                                        uint32_t v = c->targets[k];
+                                        if (s->seen[v] != s->epoch)
+                                        {
+                                                s->seen[v] = s->epoch;
+                                                queue[tail++] = v;
+                                                frontier_edges += degree(c, v);
+                                        }
+                                }
+                        }
+                        frontier_nodes = tail - head;
+                }
+                unvisited_edges -= frontier_edges;
+        }
+        return s->seen[dest] == s->epoch;
+}
+/**
+* csr_kill() - Destroy a frozen graph.
+* @c: Frozen graph to destroy.
+*
+* Returns: Nothing.
+*/
+void csr_kill(csr_graph *c)
+{
+        free(c->offsets);
+        free(c->targets);
+        free(c);
+}
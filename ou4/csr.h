@@ -0,0 +1,157 @@
+#ifndef __CSR_H
+#define __CSR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+
+/*
+ * Declaration of an immutable compressed-sparse-row (CSR) copy of a
+ * graph. A mutable graph is built with the graph interface and then
+ * frozen with graph_freeze(). The frozen graph stores the out-edges of
+ * node i as the 32-bit node ids targets[offsets[i]] up to (but not
+ * including) targets[offsets[i+1]], using the node ids of the graph it
+ * was frozen from. The frozen graph does not refer back to the graph, but
+ * it is not updated when the graph changes. After use, the function
+ * csr_kill() must be called to de-allocate its dynamic memory.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-06-21: v1.0, first public version.
+ *   2022-06-25: v1.1, searches keep their visited marks in a csr_search.
+ *   2022-07-02: v1.2, added csr_transpose() and the direction-optimizing
+ *               search csr_path_exists_hybrid().
+ *   2022-07-04: v1.3, added csr_search_from().
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+// The fields are public so that traversals can walk the arrays directly.
+typedef struct csr_graph {
+        uint32_t n;             // Number of nodes.
+        uint32_t m;             // Number of edges.
+        uint32_t *offsets;      // n+1 offsets into targets.
+        uint32_t *targets;      // m target node ids.
+} csr_graph;
+
+// Scratch space for searches over a frozen graph, kept apart from the
+// frozen graph itself. Node i is visited in the current search if
+// seen[i] == epoch, so starting a new search only increments the epoch.
+typedef struct csr_search {
+        uint32_t n;             // Number of nodes.
+        uint32_t epoch;         // Stamp of the current search.
+        uint32_t *seen;         // Visited stamp for each node.
+        uint32_t *queue;        // Room for all n nodes.
+        uint64_t *frontier;     // Bitset frontiers of bottom-up levels.
+        uint64_t *next;
+} csr_search;
+
+// =================== CSR GRAPH INTERFACE ======================
+
+/**
+ * graph_freeze() - Create a CSR copy of a graph.
+ * @g: Graph to freeze.
+ *
+ * Returns: A pointer to the frozen graph.
+ */
+csr_graph *graph_freeze(const graph *g);
+
+/**
+ * csr_transpose() - Create the transpose of a frozen graph.
+ * @c: Frozen graph.
+ *
+ * The transpose has an edge from j to i for every edge from i to j in c,
+ * so its out-edges are the in-edges of c.
+ *
+ * Returns: A pointer to the transposed graph.
+ */
+csr_graph *csr_transpose(const csr_graph *c);
+
+/**
+ * csr_search_empty() - Create scratch space for searches.
+ * @c: Frozen graph that will be searched.
+ *
+ * Returns: A pointer to the scratch space.
+ */
+csr_search *csr_search_empty(const csr_graph *c);
+
+/**
+ * csr_search_begin() - Start a new search, clearing all visited marks.
+ * @s: Scratch space to reset.
+ *
+ * Takes constant time, except when the epoch counter wraps around.
+ *
+ * Returns: Nothing.
+ */
+void csr_search_begin(csr_search *s);
+
+/**
+ * csr_search_kill() - Destroy scratch space for searches.
+ * @s: Scratch space to destroy.
+ *
+ * Returns: Nothing.
+ */
+void csr_search_kill(csr_search *s);
+
+/**
+ * csr_path_exists() - Check if there is a path between two nodes.
+ * @c: Frozen graph to search.
+ * @s: Scratch space for the search.
+ * @src: Id of the origin node.
+ * @dest: Id of the destination node.
+ *
+ * Runs a breadth-first search over the CSR arrays. The time is
+ * proportional to the part of the graph visited before dest is found.
+ *
+ * Returns: True if dest can be reached from src, otherwise false.
+ */
+bool csr_path_exists(const csr_graph *c, csr_search *s, uint32_t src,
+                     uint32_t dest);
+
+/**
+ * csr_search_from() - Visit every node that can be reached from a node.
+ * @c: Frozen graph to search.
+ * @s: Scratch space, where the visited nodes are marked.
+ * @src: Id of the origin node.
+ *
+ * After the call, node i can be reached from src if s->seen[i] ==
+ * s->epoch, so any number of destinations can be checked against one
+ * search.
+ *
+ * Returns: The number of visited nodes, including src.
+ */
+uint32_t csr_search_from(const csr_graph *c, csr_search *s, uint32_t src);
+
+/**
+ * csr_path_exists_hybrid() - Check if there is a path, switching direction.
+ * @c: Frozen graph to search.
+ * @t: Transpose of c (see csr_transpose()).
+ * @s: Scratch space for the search.
+ * @src: Id of the origin node.
+ * @dest: Id of the destination node.
+ *
+ * A direction-optimizing breadth-first search. Small frontiers are
+ * expanded top-down from a queue along the out-edges of c. When the
+ * frontier has more out-edges than the unvisited nodes have in total
+ * (scaled by a constant), the search switches to bottom-up levels where
+ * every unvisited node checks its in-edges in t for a parent in a bitset
+ * frontier, and stops at the first one found. It switches back when the
+ * frontier becomes small again. On graphs with hubs this skips most of
+ * the edges a plain search inspects.
+ *
+ * Returns: True if dest can be reached from src, otherwise false.
+ */
+bool csr_path_exists_hybrid(const csr_graph *c, const csr_graph *t,
+                            csr_search *s, uint32_t src, uint32_t dest);
+
+/**
+ * csr_kill() - Destroy a frozen graph.
+ * @c: Frozen graph to destroy.
+ *
+ * Returns: Nothing.
+ */
+void csr_kill(csr_graph *c);
+
+#endif
@@ -0,0 +1,859 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "graph.h"
+#include "csr.h"
+#include "scc.h"
+#include "union_find.h"
+#include "dynreach.h"
+
+/*
+* Implementation of a dynamic reachability layer. The condensation is
+* kept as out- and in-lists per component, with one entry for every edge
+* of the graph between two different components. Merged components are
+* joined in a union-find structure and their lists are appended to the
+* list of the representative, so list entries may name an old component
+* and are looked up with union_find_find() when they are followed.
+*
+* A component that may have split is searched again on its own with
+* Tarjan's algorithm (see scc.c). The largest piece keeps the component,
+* and the edges of the nodes in the other pieces are moved to entries of
+* their new components.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-07-07: v1.0, first public version.
+*   2022-07-14: v1.1, edges can be inserted with a weight.
+*/
+
+// Marks a search without a target.
+#define NONE UINT32_MAX
+// Largest number of nodes visited when a deleted edge is repaired.
+#define REPAIR_BUDGET 4096
+
+/*Defines a growable list of component ids */
+typedef struct comp_list
+{
+        uint32_t *items;
+        uint32_t n;
+        uint32_t size;
+} comp_list;
+/*Defines a frame of the depth-first search: a node id and the position
+of its next out-edge to follow */
+typedef struct frame
+{
+        uint32_t v;
+        graph_pos pos;
+} frame;
+/*Defines the dynamic reachability layer */
+struct dynreach
+{
+        graph *g;
+        bool stale;
+        //True while the component ids are in reverse topological order
+        bool ordered;
+        uint32_t components;
+        uint32_t comp_size;
+        union_find *merged;
+        comp_list *out;
+        comp_list *in;
+        //Node ids of each component
+        comp_list *members;
+        //Search stamps over the components
+        uint32_t epoch;
+        uint32_t *seen;
+        uint32_t *mark;
+        uint32_t *queue;
+        //Component and search stamps over the node ids
+        uint32_t node_size;
+        uint32_t *component;
+        uint32_t node_epoch;
+        uint32_t *node_seen;
+        node **node_queue;
+        dynreach_stats stats;
+};
+/**
+* list_add() - Append a component id to a list.
+* @l: List to manipulate.
+* @c: Component id.
+*
+* Returns: Nothing.
+*/
+static void list_add(comp_list *l, uint32_t c)
+{
+        if (l->n == l->size)
+        {
+                l->size = l->size > 0 ? 2 * l->size : 4;
+                l->items = realloc(l->items, l->size * sizeof(*l->items));
+        }
+        l->items[l->n++] = c;
+}
+/**
+* list_remove() - Remove one entry of a component from a list.
+* @l: List to manipulate.
+* @merged: Components joined so far.
+* @self: Representative that owns the list.
+* @c: Representative to remove.
+*
+* Entries that now name the owner itself are dropped on the way.
+*
+* Returns: Nothing.
+*/
+static void list_remove(comp_list *l, union_find *merged, uint32_t self,
+                        uint32_t c)
+{
+        for (uint32_t i = 0; i < l->n; i++)
+        {
+                uint32_t t = union_find_find(merged, l->items[i]);
+                if (t == self || t == c)
+                {
+                        l->items[i--] = l->items[--l->n];
+                }
+                if (t == c)
+                {
+                        return;
+                }
+        }
+}
+/**
+* list_move() - Append all ids of a list to another and empty it.
+* @dst: List to append to.
+* @src: List to move from.
+*
+* Returns: Nothing.
+*/
+static void list_move(comp_list *dst, comp_list *src)
+{
+        for (uint32_t i = 0; i < src->n; i++)
+        {
+                list_add(dst, src->items[i]);
+        }
+        src->n = 0;
+}
+/**
+* ensure_components() - Make room for a number of components.
+* @d: Layer to manipulate.
+* @count: Number of components needed.
+*
+* Returns: Nothing.
+*/
+static void ensure_components(dynreach *d, uint32_t count)
+{
+        if (count <= d->comp_size)
+        {
+                return;
+        }
+        uint32_t size = d->comp_size > 0 ? d->comp_size : 16;
+        while (size < count)
+        {
+                size *= 2;
+        }
+        d->out = realloc(d->out, size * sizeof(*d->out));
+        d->in = realloc(d->in, size * sizeof(*d->in));
+        d->members = realloc(d->members, size * sizeof(*d->members));
+        d->seen = realloc(d->seen, size * sizeof(*d->seen));
+        d->mark = realloc(d->mark, size * sizeof(*d->mark));
+        d->queue = realloc(d->queue, size * sizeof(*d->queue));
+        uint32_t added = size - d->comp_size;
+        memset(d->out + d->comp_size, 0, added * sizeof(*d->out));
+        memset(d->in + d->comp_size, 0, added * sizeof(*d->in));
+        memset(d->members + d->comp_size, 0, added * sizeof(*d->members));
+        memset(d->seen + d->comp_size, 0, added * sizeof(*d->seen));
+        memset(d->mark + d->comp_size, 0, added * sizeof(*d->mark));
+        d->comp_size = size;
+}
+/**
+* ensure_nodes() - Make room for a number of node ids.
+* @d: Layer to manipulate.
+* @count: Number of node ids needed.
+*
+* Returns: Nothing.
+*/
+static void ensure_nodes(dynreach *d, uint32_t count)
+{
+        if (count <= d->node_size)
+        {
+                return;
+        }
+        uint32_t size = d->node_size > 0 ? d->node_size : 16;
+        while (size < count)
+        {
+                size *= 2;
+        }
+        d->component = realloc(d->component, size * sizeof(*d->component));
+        d->node_seen = realloc(d->node_seen, size * sizeof(*d->node_seen));
+        d->node_queue = realloc(d->node_queue, size * sizeof(*d->node_queue));
+        memset(d->node_seen + d->node_size, 0,
+               (size - d->node_size) * sizeof(*d->node_seen));
+        d->node_size = size;
+}
+/**
+* begin_search() - Start a new search over the components.
+* @d: Layer to manipulate.
+*
+* Returns: Nothing.
+*/
+static void begin_search(dynreach *d)
+{
+        d->epoch++;
+        if (d->epoch == 0)
+        {       //The stamps wrapped around, so old ones could match
+                memset(d->seen, 0, d->comp_size * sizeof(*d->seen));
+                memset(d->mark, 0, d->comp_size * sizeof(*d->mark));
+                d->epoch = 1;
+        }
+}
+/**
+* rep() - Return the current component of a node.
+* @d: Layer to inspect.
+* @n: Node.
+*
+* Returns: The representative component id.
+*/
+static uint32_t rep(dynreach *d, const node *n)
+{
+        return union_find_find(d->merged, d->component[graph_node_id(d->g, n)]);
+}
+/**
+* rebuild() - Build the components and condensation from the graph.
+* @d: Layer to manipulate.
+*
+* Returns: Nothing.
+*/
+static void rebuild(dynreach *d)
+{
+        scc_graph *s = graph_condense(d->g);
+        ensure_nodes(d, s->n);
+        memcpy(d->component, s->component, s->n * sizeof(*s->component));
+        ensure_components(d, s->components);
+        for (uint32_t c = 0; c < d->comp_size; c++)
+        {
+                d->out[c].n = 0;
+                d->in[c].n = 0;
+                d->members[c].n = 0;
+        }
+        d->components = s->components;
+        union_find_clear(d->merged);
+        for (uint32_t c = 0; c < s->components; c++)
+        {
+                union_find_add(d->merged);
+        }
+        for (uint32_t i = 0; i < s->n; i++)
+        {
+                list_add(&d->members[s->component[i]], i);
+        }
+        scc_kill(s);
+        //Unlike s->dag the lists keep every edge, so deletions can be undone
+        for (int i = 0; i < graph_node_count(d->g); i++)
+        {
+                node *v = graph_node_by_id(d->g, i);
+                uint32_t c1 = d->component[i];
+                graph_pos p = graph_neighbour_first(d->g, v);
+                for (; !graph_neighbour_is_end(d->g, p); p = graph_neighbour_next(d->g, p))
+                {
+                        node *w = graph_neighbour_inspect(d->g, p);
+                        uint32_t c2 = d->component[graph_node_id(d->g, w)];
+                        if (c1 != c2)
+                        {
+                                list_add(&d->out[c1], c2);
+                                list_add(&d->in[c2], c1);
+                        }
+                }
+        }
+        d->stale = false;
+        d->ordered = true;
+}
+/**
+* search_forward() - Mark the components reachable from a component.
+* @d: Layer to search.
+* @from: Representative to start from.
+* @to: Representative to look for, or NONE to mark all.
+*
+* The marked components have seen[c] == d->epoch.
+*
+* Returns: True if to was reached, otherwise false.
+*/
+static bool search_forward(dynreach *d, uint32_t from, uint32_t to)
+{
+        begin_search(d);
+        uint32_t head = 0;
+        uint32_t tail = 0;
+        d->seen[from] = d->epoch;
+        d->queue[tail++] = from;
+        while (head < tail)
+        {
+                uint32_t c = d->queue[head++];
+                const comp_list *l = &d->out[c];
+                for (uint32_t i = 0; i < l->n; i++)
+                {
+                        uint32_t t = union_find_find(d->merged, l->items[i]);
+                        if (t == c || d->seen[t] == d->epoch)
+                        {
+                                continue;
+                        }
+                        if (t == to)
+                        {
+                                return true;
+                        }
+                        d->seen[t] = d->epoch;
+                        d->queue[tail++] = t;
+                }
+        }
+        return false;
+}
+/**
+* merge_cycle() - Merge the components on the paths from one component to
+* another.
+* @d: Layer to manipulate.
+* @from: Representative where the paths start, marked by search_forward().
+* @to: Representative where the paths end.
+*
+* A component is on such a path if it is reachable from from and reaches
+* to. The second set is found with a backward search from to that only
+* visits components marked by the forward search.
+*
+* Returns: Nothing.
+*/
+static void merge_cycle(dynreach *d, uint32_t from, uint32_t to)
+{
+        uint32_t head = 0;
+        uint32_t tail = 0;
+        d->mark[to] = d->epoch;
+        d->queue[tail++] = to;
+        while (head < tail)
+        {
+                uint32_t c = d->queue[head++];
+                const comp_list *l = &d->in[c];
+                for (uint32_t i = 0; i < l->n; i++)
+                {
+                        uint32_t t = union_find_find(d->merged, l->items[i]);
+                        if (d->seen[t] == d->epoch && d->mark[t] != d->epoch)
+                        {
+                                d->mark[t] = d->epoch;
+                                d->queue[tail++] = t;
+                        }
+                }
+        }
+        //The queue now holds every component on the cycle, from included
+        for (uint32_t i = 1; i < tail; i++)
+        {
+                union_find_union(d->merged, to, d->queue[i]);
+        }
+        uint32_t r = union_find_find(d->merged, to);
+        for (uint32_t i = 0; i < tail; i++)
+        {
+                uint32_t c = d->queue[i];
+                if (c != r)
+                {
+                        list_move(&d->out[r], &d->out[c]);
+                        list_move(&d->in[r], &d->in[c]);
+                        list_move(&d->members[r], &d->members[c]);
+                }
+        }
+        d->stats.merges++;
+}
+/**
+* still_reaches() - Check if a deleted edge inside a component can be
+* bypassed.
+* @d: Layer to search.
+* @n1: Source node of the deleted edge.
+* @n2: Destination node of the deleted edge.
+*
+* If n1 still reaches n2, every cycle that used the edge can use the
+* other path instead, so the component is intact. The search visits at
+* most REPAIR_BUDGET nodes.
+*
+* Returns: True if another path was found, false if none was found
+* within the budget.
+*/
+static bool still_reaches(dynreach *d, const node *n1, const node *n2)
+{
+        if (n1 == n2)
+        {       //A loop is on no path between two different nodes
+                return true;
+        }
+        d->node_epoch++;
+        if (d->node_epoch == 0)
+        {
+                memset(d->node_seen, 0, d->node_size * sizeof(*d->node_seen));
+                d->node_epoch = 1;
+        }
+        int head = 0;
+        int tail = 0;
+        d->node_seen[graph_node_id(d->g, n1)] = d->node_epoch;
+        d->node_queue[tail++] = (node *)n1;
+        while (head < tail)
+        {
+                node *v = d->node_queue[head++];
+                graph_pos p = graph_neighbour_first(d->g, v);
+                for (; !graph_neighbour_is_end(d->g, p); p = graph_neighbour_next(d->g, p))
+                {
+                        node *w = graph_neighbour_inspect(d->g, p);
+                        int id = graph_node_id(d->g, w);
+                        if (d->node_seen[id] == d->node_epoch)
+                        {
+                                continue;
+                        }
+                        if (w == n2)
+                        {
+                                return true;
+                        }
+                        if (tail == REPAIR_BUDGET)
+                        {
+                                return false;
+                        }
+                        d->node_seen[id] = d->node_epoch;
+                        d->node_queue[tail++] = w;
+                }
+        }
+        return false;
+}
+/**
+* find_pieces() - Find the components of the subgraph of one component.
+* @d: Layer to inspect.
+* @c: Representative of the component.
+* @piece: Array over the node ids, filled in for the nodes of c.
+*
+* Tarjan's algorithm as in scc.c, following only the edges that stay
+* inside c. The pieces are numbered 0, 1, ...
+*
+* Returns: The number of pieces.
+*/
+static uint32_t find_pieces(dynreach *d, uint32_t c, uint32_t *piece)
+{
+        const comp_list *m = &d->members[c];
+        uint32_t n = graph_node_count(d->g);
+        uint32_t *index = malloc(n * sizeof(*index));
+        uint32_t *low = malloc(n * sizeof(*low));
+        uint32_t *stack = malloc(m->n * sizeof(*stack));
+        frame *frames = malloc(m->n * sizeof(*frames));
+        uint32_t next_index = 0;
+        uint32_t pieces = 0;
+        uint32_t top = 0;
+
+        for (uint32_t i = 0; i < m->n; i++)
+        {
+                index[m->items[i]] = NONE;
+                piece[m->items[i]] = NONE;
+        }
+        for (uint32_t i = 0; i < m->n; i++)
+        {
+                uint32_t root = m->items[i];
+                if (index[root] != NONE)
+                {
+                        continue;
+                }
+                int depth = 0;
+                index[root] = low[root] = next_index++;
+                stack[top++] = root;
+                frames[depth].v = root;
+                frames[depth].pos = graph_neighbour_first(d->g, graph_node_by_id(d->g, root));
+                while (depth >= 0)
+                {
+                        frame *f = &frames[depth];
+                        if (!graph_neighbour_is_end(d->g, f->pos))
+                        {
+                                node *wn = graph_neighbour_inspect(d->g, f->pos);
+                                f->pos = graph_neighbour_next(d->g, f->pos);
+                                if (rep(d, wn) != c)
+                                {
+                                        continue;
+                                }
+                                uint32_t w = graph_node_id(d->g, wn);
+                                if (index[w] == NONE)
+                                {
+                                        index[w] = low[w] = next_index++;
+                                        stack[top++] = w;
+                                        depth++;
+                                        frames[depth].v = w;
+                                        frames[depth].pos = graph_neighbour_first(d->g, wn);
+                                }
+                                else if (piece[w] == NONE && index[w] < low[f->v])
+                                {
+                                        low[f->v] = index[w];
+                                }
+                                continue;
+                        }
+                        uint32_t v = f->v;
+                        if (low[v] == index[v])
+                        {
+                                uint32_t w;
+                                do
+                                {
+                                        w = stack[--top];
+                                        piece[w] = pieces;
+                                } while (w != v);
+                                pieces++;
+                        }
+                        depth--;
+                        if (depth >= 0 && low[v] < low[frames[depth].v])
+                        {
+                                low[frames[depth].v] = low[v];
+                        }
+                }
+        }
+        free(index);
+        free(low);
+        free(stack);
+        free(frames);
+        return pieces;
+}
+/**
+* move_edges() - Give the edges of a node that left a component entries of
+* its own.
+* @d: Layer to manipulate.
+* @v: Node id, already given its new component.
+* @c: Representative of the component that was split.
+* @first: First new component id.
+*
+* Before the split an edge between v and another component was listed
+* under c. Those entries are replaced. An edge to a node that stayed in c
+* or to another new piece had no entry and gets one. Edges between two new
+* pieces are added from their origin only.
+*
+* Returns: Nothing.
+*/
+static void move_edges(dynreach *d, uint32_t v, uint32_t c, uint32_t first)
+{
+        node *n = graph_node_by_id(d->g, v);
+        uint32_t p = d->component[v];
+        graph_pos pos = graph_neighbour_first(d->g, n);
+        for (; !graph_neighbour_is_end(d->g, pos); pos = graph_neighbour_next(d->g, pos))
+        {
+                uint32_t t = rep(d, graph_neighbour_inspect(d->g, pos));
+                if (t == p)
+                {
+                        continue;
+                }
+                if (t != c && t < first)
+                {
+                        list_remove(&d->out[c], d->merged, c, t);
+                        list_remove(&d->in[t], d->merged, t, c);
+                }
+                list_add(&d->out[p], t);
+                list_add(&d->in[t], p);
+        }
+        pos = graph_in_neighbour_first(d->g, n);
+        for (; !graph_neighbour_is_end(d->g, pos); pos = graph_in_neighbour_next(d->g, pos))
+        {
+                uint32_t t = rep(d, graph_neighbour_inspect(d->g, pos));
+                if (t == p || t >= first)
+                {
+                        continue;
+                }
+                if (t != c)
+                {
+                        list_remove(&d->in[c], d->merged, c, t);
+                        list_remove(&d->out[t], d->merged, t, c);
+                }
+                list_add(&d->in[p], t);
+                list_add(&d->out[t], p);
+        }
+}
+/**
+* split_component() - Repair a component after an edge inside it was
+* deleted.
+* @d: Layer to manipulate.
+* @c: Representative of the component.
+*
+* The largest piece keeps the id c and its lists, and the other pieces get
+* new ids. Only the edges of the nodes that left c are visited, so losing
+* a few nodes from a large component is cheap.
+*
+* Returns: Nothing.
+*/
+static void split_component(dynreach *d, uint32_t c)
+{
+        uint32_t *piece = malloc(graph_node_count(d->g) * sizeof(*piece));
+        uint32_t pieces = find_pieces(d, c, piece);
+        if (pieces == 1)
+        {
+                free(piece);
+                d->stats.repairs++;
+                return;
+        }
+        comp_list *m = &d->members[c];
+        uint32_t *size = calloc(pieces, sizeof(*size));
+        uint32_t largest = 0;
+        for (uint32_t i = 0; i < m->n; i++)
+        {
+                if (++size[piece[m->items[i]]] > size[largest])
+                {
+                        largest = piece[m->items[i]];
+                }
+        }
+        free(size);
+        //The other pieces get new ids, since a union-find set can not be split
+        uint32_t first = d->components;
+        ensure_components(d, first + pieces - 1);
+        m = &d->members[c];
+        for (uint32_t k = 0; k + 1 < pieces; k++)
+        {
+                union_find_add(d->merged);
+                d->out[first + k].n = 0;
+                d->in[first + k].n = 0;
+                d->members[first + k].n = 0;
+        }
+        d->components += pieces - 1;
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < m->n; i++)
+        {
+                uint32_t v = m->items[i];
+                if (piece[v] == largest)
+                {
+                        m->items[kept++] = v;
+                        continue;
+                }
+                uint32_t k = piece[v] < largest ? piece[v] : piece[v] - 1;
+                d->component[v] = first + k;
+                list_add(&d->members[first + k], v);
+        }
+        m->n = kept;
+        free(piece);
+        for (uint32_t k = 0; k + 1 < pieces; k++)
+        {
+                const comp_list *l = &d->members[first + k];
+                for (uint32_t i = 0; i < l->n; i++)
+                {
+                        move_edges(d, l->items[i], c, first);
+                }
+        }
+        d->ordered = false;
+        d->stats.splits++;
+}
+/**
+* count_edges() - Count the edges between two nodes.
+* @g: Graph to inspect.
+* @n1: Source node.
+* @n2: Destination node.
+*
+* Returns: The number of edges from n1 to n2.
+*/
+static int count_edges(const graph *g, const node *n1, const node *n2)
+{
+        int count = 0;
+        graph_pos p = graph_neighbour_first(g, n1);
+        for (; !graph_neighbour_is_end(g, p); p = graph_neighbour_next(g, p))
+        {
+                if (graph_neighbour_inspect(g, p) == n2)
+                {
+                        count++;
+                }
+        }
+        return count;
+}
+/**
+* dynreach_empty() - Create a dynamic reachability layer over a graph.
+* @g: Graph to follow.
+*
+* Returns: A pointer to the new layer.
+*/
+dynreach *dynreach_empty(graph *g)
+{
+        dynreach *d = calloc(1, sizeof(*d));
+        d->g = g;
+        d->merged = union_find_empty(graph_node_count(g));
+        rebuild(d);
+        return d;
+}
+/**
+* dynreach_graph() - Return the graph of a layer.
+* @d: Layer to inspect.
+*
+* Returns: The graph.
+*/
+graph *dynreach_graph(const dynreach *d)
+{
+        return d->g;
+}
+/**
+* dynreach_insert_node() - Insert a node into the graph of a layer.
+* @d: Layer to manipulate.
+* @s: Name of the node.
+*
+* Returns: The modified graph.
+*/
+graph *dynreach_insert_node(dynreach *d, const char *s)
+{
+        int count = graph_node_count(d->g);
+        d->g = graph_insert_node(d->g, s);
+        if (d->stale || graph_node_count(d->g) == count)
+        {
+                return d->g;
+        }
+        int id = graph_node_id(d->g, graph_find_node(d->g, s));
+        ensure_nodes(d, graph_node_count(d->g));
+        ensure_components(d, d->components + 1);
+        //A node without edges fits anywhere in the order, so it may come first
+        uint32_t c = d->components++;
+        union_find_add(d->merged);
+        d->out[c].n = 0;
+        d->in[c].n = 0;
+        d->members[c].n = 0;
+        list_add(&d->members[c], id);
+        d->component[id] = c;
+        return d->g;
+}
+/**
+* dynreach_delete_node() - Delete a node from the graph of a layer.
+* @d: Layer to manipulate.
+* @n: Node to delete.
+*
+* Returns: The modified graph.
+*/
+graph *dynreach_delete_node(dynreach *d, node *n)
+{
+        d->g = graph_delete_node(d->g, n);
+        d->stale = true;
+        return d->g;
+}
+/**
+* dynreach_insert_edge() - Insert an edge into the graph of a layer.
+* @d: Layer to manipulate.
+* @n1: Source node (origin) of the edge.
+* @n2: Destination node of the edge.
+*
+* Returns: The modified graph.
+*/
+graph *dynreach_insert_edge(dynreach *d, node *n1, node *n2)
+{
+        return dynreach_insert_weighted_edge(d, n1, n2, 1);
+}
+/**
+* dynreach_insert_weighted_edge() - Insert an edge with a weight into the
+* graph of a layer.
+* @d: Layer to manipulate.
+* @n1: Source node (origin) of the edge.
+* @n2: Destination node of the edge.
+* @weight: Weight of the edge.
+*
+* Returns: The modified graph.
+*/
+graph *dynreach_insert_weighted_edge(dynreach *d, node *n1, node *n2, double weight)
+{
+        int before = d->stale ? 0 : count_edges(d->g, n1, n2);
+        d->g = graph_insert_weighted_edge(d->g, n1, n2, weight);
+        if (d->stale || (before > 0 && count_edges(d->g, n1, n2) == before))
+        {       //The graph keeps one edge per pair of nodes
+                return d->g;
+        }
+        uint32_t c1 = rep(d, n1);
+        uint32_t c2 = rep(d, n2);
+        if (c1 == c2)
+        {
+                return d->g;
+        }
+        list_add(&d->out[c1], c2);
+        list_add(&d->in[c2], c1);
+        if (d->ordered && c1 > c2)
+        {       //Keeps the order, so the edge can not close a cycle
+                return d->g;
+        }
+        d->ordered = false;
+        if (search_forward(d, c2, c1))
+        {       //The edge closes a cycle, so mark everything c2 reaches
+                search_forward(d, c2, NONE);
+                merge_cycle(d, c2, c1);
+        }
+        return d->g;
+}
+/**
+* dynreach_delete_edge() - Delete an edge from the graph of a layer.
+* @d: Layer to manipulate.
+* @n1: Source node (origin) of the edge.
+* @n2: Destination node of the edge.
+*
+* Returns: The modified graph.
+*/
+graph *dynreach_delete_edge(dynreach *d, node *n1, node *n2)
+{
+        if (d->stale || count_edges(d->g, n1, n2) == 0)
+        {       //Lets the graph report a missing edge
+                d->g = graph_delete_edge(d->g, n1, n2);
+                return d->g;
+        }
+        d->g = graph_delete_edge(d->g, n1, n2);
+        uint32_t c1 = rep(d, n1);
+        uint32_t c2 = rep(d, n2);
+        if (c1 != c2)
+        {       //The edge is on no cycle, so only its own entries go
+                list_remove(&d->out[c1], d->merged, c1, c2);
+                list_remove(&d->in[c2], d->merged, c2, c1);
+        }
+        else if (still_reaches(d, n1, n2))
+        {
+                d->stats.repairs++;
+        }
+        else
+        {
+                split_component(d, c1);
+        }
+        return d->g;
+}
+/**
+* dynreach_path_exists() - Check if there is a path between two nodes.
+* @d: Layer to search.
+* @n1: Origin node.
+* @n2: Destination node.
+*
+* Returns: True if n2 can be reached from n1, otherwise false.
+*/
+bool dynreach_path_exists(dynreach *d, const node *n1, const node *n2)
+{
+        if (d->stale)
+        {
+                rebuild(d);
+                d->stats.rebuilds++;
+        }
+        uint32_t c1 = rep(d, n1);
+        uint32_t c2 = rep(d, n2);
+        if (c1 == c2)
+        {
+                return true;
+        }
+        if (d->ordered && c1 < c2)
+        {       //Edges only go from higher to lower component ids
+                return false;
+        }
+        return search_forward(d, c1, c2);
+}
+/**
+* dynreach_get_stats() - Return the counters of a layer.
+* @d: Layer to inspect.
+*
+* Returns: The counters.
+*/
+dynreach_stats dynreach_get_stats(const dynreach *d)
+{
+        return d->stats;
+}
+/**
+* dynreach_kill() - Destroy a dynamic reachability layer.
+* @d: Layer to destroy.
+*
+* Returns: Nothing.
+*/
+void dynreach_kill(dynreach *d)
+{
+        for (uint32_t c = 0; c < d->comp_size; c++)
+        {
+                free(d->out[c].items);
+                free(d->in[c].items);
+                free(d->members[c].items);
+        }
+        free(d->out);
+        free(d->in);
+        free(d->members);
+        free(d->seen);
+        free(d->mark);
+        free(d->queue);
+        free(d->component);
+        free(d->node_seen);
+        free(d->node_queue);
+        union_find_kill(d->merged);
+        free(d);
+}
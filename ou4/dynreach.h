@@ -0,0 +1,149 @@
+#ifndef __DYNREACH_H
+#define __DYNREACH_H
+
+#include <stdbool.h>
+#include "graph.h"
+
+/*
+ * Declaration of a dynamic reachability layer over a graph. The layer
+ * keeps the strongly connected components and the condensation of the
+ * graph (see scc.h) up to date while edges are inserted and deleted
+ * through it, so queries do not have to search the whole graph.
+ *
+ * An inserted edge between two components adds an edge to the
+ * condensation, and if it closes a cycle the components on the cycle are
+ * merged. A deleted edge between two components is removed from the
+ * condensation. A deleted edge inside a component may split it, so a
+ * search of bounded size looks for another path between its end nodes.
+ * If none is found only that component is searched again and split, so
+ * the repair is bounded by the size of the component and its neighbours.
+ * Deleting a node marks the condensation stale, and it is rebuilt by the
+ * next query.
+ *
+ * The graph must only be changed through the layer while it is in use.
+ * After use, the function dynreach_kill() must be called to de-allocate
+ * the dynamic memory of the layer. The graph is not destroyed.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-07-07: v1.0, first public version.
+ *   2022-07-14: v1.1, added dynreach_insert_weighted_edge().
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct dynreach dynreach;
+
+typedef struct dynreach_stats {
+        long merges;            // Inserted edges that closed a cycle.
+        long repairs;           // Deleted edges in a component that kept it.
+        long splits;            // Deleted edges that split a component.
+        long rebuilds;          // Condensations built after the first.
+} dynreach_stats;
+
+// =================== DYNAMIC REACHABILITY INTERFACE ======================
+
+/**
+ * dynreach_empty() - Create a dynamic reachability layer over a graph.
+ * @g: Graph to follow.
+ *
+ * Returns: A pointer to the new layer.
+ */
+dynreach *dynreach_empty(graph *g);
+
+/**
+ * dynreach_graph() - Return the graph of a layer.
+ * @d: Layer to inspect.
+ *
+ * Returns: The graph.
+ */
+graph *dynreach_graph(const dynreach *d);
+
+/**
+ * dynreach_insert_node() - Insert a node into the graph of a layer.
+ * @d: Layer to manipulate.
+ * @s: Name of the node.
+ *
+ * The node starts in a component of its own.
+ *
+ * Returns: The modified graph.
+ */
+graph *dynreach_insert_node(dynreach *d, const char *s);
+
+/**
+ * dynreach_delete_node() - Delete a node from the graph of a layer.
+ * @d: Layer to manipulate.
+ * @n: Node to delete.
+ *
+ * Node ids may change, so the condensation is rebuilt by the next query.
+ *
+ * Returns: The modified graph.
+ */
+graph *dynreach_delete_node(dynreach *d, node *n);
+
+/**
+ * dynreach_insert_edge() - Insert an edge into the graph of a layer.
+ * @d: Layer to manipulate.
+ * @n1: Source node (origin) of the edge.
+ * @n2: Destination node of the edge.
+ *
+ * Returns: The modified graph.
+ */
+graph *dynreach_insert_edge(dynreach *d, node *n1, node *n2);
+
+/**
+ * dynreach_insert_weighted_edge() - Insert an edge with a weight into the
+ * graph of a layer.
+ * @d: Layer to manipulate.
+ * @n1: Source node (origin) of the edge.
+ * @n2: Destination node of the edge.
+ * @weight: Weight of the edge.
+ *
+ * dynreach_insert_edge() gives the edge the weight 1. The weight does not
+ * matter for reachability.
+ *
+ * Returns: The modified graph.
+ */
+graph *dynreach_insert_weighted_edge(dynreach *d, node *n1, node *n2, double weight);
+
+/**
+ * dynreach_delete_edge() - Delete an edge from the graph of a layer.
+ * @d: Layer to manipulate.
+ * @n1: Source node (origin) of the edge.
+ * @n2: Destination node of the edge.
+ *
+ * Returns: The modified graph.
+ */
+graph *dynreach_delete_edge(dynreach *d, node *n1, node *n2);
+
+/**
+ * dynreach_path_exists() - Check if there is a path between two nodes.
+ * @d: Layer to search.
+ * @n1: Origin node.
+ * @n2: Destination node.
+ *
+ * Rebuilds the condensation first if it is stale.
+ *
+ * Returns: True if n2 can be reached from n1, otherwise false.
+ */
+bool dynreach_path_exists(dynreach *d, const node *n1, const node *n2);
+
+/**
+ * dynreach_get_stats() - Return the counters of a layer.
+ * @d: Layer to inspect.
+ *
+ * Returns: The counters.
+ */
+dynreach_stats dynreach_get_stats(const dynreach *d);
+
+/**
+ * dynreach_kill() - Destroy a dynamic reachability layer.
+ * @d: Layer to destroy.
+ *
+ * Returns: Nothing.
+ */
+void dynreach_kill(dynreach *d);
+
+#endif
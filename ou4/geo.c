@@ -0,0 +1,196 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "graph.h"
+#include "geo.h"
+
+/*
+* Implementation of the coordinates of the nodes of a graph. Each node is
+* stored as a point on the unit sphere, so the great-circle distance
+* between two nodes follows from the straight line between their points
+* with a square root and an arcsine, without converting any angles at
+* query time.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-07-12: v1.0, first public version.
+*/
+
+// Mean radius of the earth in kilometres.
+#define EARTH_RADIUS 6371.0
+#define PI 3.14159265358979323846
+// The bound is shrunk by this factor, so rounding can not make it larger
+// than the cost of an edge.
+#define SHRINK (1 - 1e-9)
+
+/*Defines a point on the unit sphere */
+typedef struct point
+{
+        double x;
+        double y;
+        double z;
+} point;
+/*Defines the coordinates. known[id] tells if node id has a point, and
+scale is the lowest cost per kilometre of the edges seen, or INFINITY if
+no edge joins two nodes at different places */
+struct geo
+{
+        point *points;
+        bool *known;
+        int size;
+        int located;
+        double scale;
+};
+/**
+* geo_empty() - Create an empty set of coordinates.
+*
+* Returns: A pointer to the new set, where no node has coordinates.
+*/
+geo *geo_empty(void)
+{
+        geo *c = calloc(1, sizeof(*c));
+        c->scale = INFINITY;
+        return c;
+}
+/**
+* geo_set() - Set the coordinates of a node.
+* @c: Coordinates to manipulate.
+* @id: Id of the node.
+* @lat: Latitude in degrees, in the range [-90, 90].
+* @lon: Longitude in degrees, in the range [-180, 180].
+*
+* Returns: Nothing.
+*/
+void geo_set(geo *c, int id, double lat, double lon)
+{
+        if (id >= c->size)
+        {       //Grows the arrays to fit the id
+                int size = c->size > 0 ? c->size : 64;
+                while (size <= id)
+                {
+                        size *= 2;
+                }
+                c->points = realloc(c->points, size * sizeof(*c->points));
+                c->known = realloc(c->known, size * sizeof(*c->known));
+                for (int i = c->size; i < size; i++)
+                {
+                        c->known[i] = false;
+                }
+                c->size = size;
+        }
+        if (!c->known[id])
+        {
+                c->known[id] = true;
+                c->located++;
+        }
+        double phi = lat * PI / 180;
+        double lambda = lon * PI / 180;
+        c->points[id].x = cos(phi) * cos(lambda);
+        c->points[id].y = cos(phi) * sin(lambda);
+        c->points[id].z = sin(phi);
+}
+/**
+* geo_covers() - Check if all nodes of a graph have coordinates.
+* @c: Coordinates to inspect.
+* @n: Number of nodes, i.e. the ids are in the range [0, n).
+*
+* Returns: True if every node has coordinates, otherwise false.
+*/
+bool geo_covers(const geo *c, int n)
+{
+        //Only ids in the graph are ever set, so counting is enough
+        return c->located == n;
+}
+/**
+* geo_distance() - Return the great-circle distance between two nodes.
+* @c: Coordinates to inspect.
+* @a: Id of a node with coordinates.
+* @b: Id of another node with coordinates.
+*
+* Returns: The distance in kilometres.
+*/
+double geo_distance(const geo *c, int a, int b)
+{
+        double dx = c->points[a].x - c->points[b].x;
+        double dy = c->points[a].y - c->points[b].y;
+        double dz = c->points[a].z - c->points[b].z;
+        //The chord between the points spans twice the half angle
+        double half_chord = sqrt(dx * dx + dy * dy + dz * dz) / 2;
+        return 2 * EARTH_RADIUS * asin(half_chord < 1 ? half_chord : 1);
+}
+/**
+* geo_fit_edges() - Lower the cost per kilometre to fit all edges of a
+* graph.
+* @c: Coordinates of all nodes of g.
+* @g: Graph whose edge weights are all non-negative.
+*
+* Returns: Nothing.
+*/
+void geo_fit_edges(geo *c, const graph *g)
+{
+        int n = graph_node_count(g);
+        for (int v = 0; v < n; v++)
+        {
+                node *from = graph_node_by_id(g, v);
+                graph_pos p = graph_neighbour_first(g, from);
+                for (; !graph_neighbour_is_end(g, p); p = graph_neighbour_next(g, p))
+                {
+                        int w = graph_node_id(g, graph_neighbour_inspect(g, p));
+                        geo_edge_inserted(c, v, w, graph_neighbour_weight(g, p));
+                }
+        }
+}
+/**
+* geo_edge_inserted() - Lower the cost per kilometre to fit a new edge.
+* @c: Coordinates to manipulate.
+* @a: Id of the origin of the edge.
+* @b: Id of the destination of the edge.
+* @weight: Weight of the edge.
+*
+* Returns: Nothing.
+*/
+void geo_edge_inserted(geo *c, int a, int b, double weight)
+{
+        if (a >= c->size || b >= c->size || !c->known[a] || !c->known[b])
+        {
+                return;
+        }
+        double distance = geo_distance(c, a, b);
+        //An edge within one place puts no limit on the scale
+        if (distance > 0 && weight / distance < c->scale)
+        {
+                c->scale = weight / distance;
+        }
+}
+/**
+* geo_bound() - Return a lower bound on the cost of a route.
+* @c: Coordinates fitted to all edges of the graph.
+* @a: Id of the origin.
+* @b: Id of the destination.
+*
+* Returns: The distance between a and b times the lowest cost per
+* kilometre of any edge.
+*/
+double geo_bound(const geo *c, int a, int b)
+{
+        if (isinf(c->scale))
+        {       //No edge leaves its place, so no route does either
+                return 0;
+        }
+        return c->scale * SHRINK * geo_distance(c, a, b);
+}
+/**
+* geo_kill() - Destroy a set of coordinates.
+* @c: Coordinates to destroy.
+*
+* Returns: Nothing.
+*/
+void geo_kill(geo *c)
+{
+        free(c->points);
+        free(c->known);
+        free(c);
+}
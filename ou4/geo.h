@@ -0,0 +1,111 @@
+#ifndef __GEO_H
+#define __GEO_H
+
+#include <stdbool.h>
+#include "graph.h"
+
+/*
+ * Declaration of the coordinates of the nodes of a graph, given as
+ * latitude and longitude in degrees. They give a lower bound on the cost
+ * of a route between two nodes: the great-circle distance between them
+ * times the lowest cost per kilometre of any edge. The bound never
+ * overestimates and it obeys the triangle inequality, so it can guide an
+ * A* search without settling a node twice. After use, the function
+ * geo_kill() must be called to de-allocate the dynamic memory.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-07-12: v1.0, first public version.
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct geo geo;
+
+// =================== COORDINATES INTERFACE ======================
+
+/**
+ * geo_empty() - Create an empty set of coordinates.
+ *
+ * Returns: A pointer to the new set, where no node has coordinates.
+ */
+geo *geo_empty(void);
+
+/**
+ * geo_set() - Set the coordinates of a node.
+ * @c: Coordinates to manipulate.
+ * @id: Id of the node.
+ * @lat: Latitude in degrees, in the range [-90, 90].
+ * @lon: Longitude in degrees, in the range [-180, 180].
+ *
+ * Returns: Nothing.
+ */
+void geo_set(geo *c, int id, double lat, double lon);
+
+/**
+ * geo_covers() - Check if all nodes of a graph have coordinates.
+ * @c: Coordinates to inspect.
+ * @n: Number of nodes, i.e. the ids are in the range [0, n).
+ *
+ * Returns: True if every node has coordinates, otherwise false.
+ */
+bool geo_covers(const geo *c, int n);
+
+/**
+ * geo_distance() - Return the great-circle distance between two nodes.
+ * @c: Coordinates to inspect.
+ * @a: Id of a node with coordinates.
+ * @b: Id of another node with coordinates.
+ *
+ * Returns: The distance in kilometres.
+ */
+double geo_distance(const geo *c, int a, int b);
+
+/**
+ * geo_fit_edges() - Lower the cost per kilometre to fit all edges of a
+ * graph.
+ * @c: Coordinates of all nodes of g.
+ * @g: Graph whose edge weights are all non-negative.
+ *
+ * Returns: Nothing.
+ */
+void geo_fit_edges(geo *c, const graph *g);
+
+/**
+ * geo_edge_inserted() - Lower the cost per kilometre to fit a new edge.
+ * @c: Coordinates to manipulate.
+ * @a: Id of the origin of the edge.
+ * @b: Id of the destination of the edge.
+ * @weight: Weight of the edge.
+ *
+ * Edges to or from a node without coordinates are ignored, since such a
+ * node leaves geo_covers() false until it gets them.
+ *
+ * Returns: Nothing.
+ */
+void geo_edge_inserted(geo *c, int a, int b, double weight);
+
+/**
+ * geo_bound() - Return a lower bound on the cost of a route.
+ * @c: Coordinates fitted to all edges of the graph.
+ * @a: Id of the origin.
+ * @b: Id of the destination.
+ *
+ * Only valid while geo_covers() holds for the graph.
+ *
+ * Returns: The distance between a and b times the lowest cost per
+ * kilometre of any edge.
+ */
+double geo_bound(const geo *c, int a, int b);
+
+/**
+ * geo_kill() - Destroy a set of coordinates.
+ * @c: Coordinates to destroy.
+ *
+ * Returns: Nothing.
+ */
+void geo_kill(geo *c);
+
+#endif
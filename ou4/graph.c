@@ -5,6 +5,10 @@
 
 #include "graph.h"
 #include "dlist.h"
+#include "name_index.h"
+#include "bitset.h"
+#include "arena.h"
+#include "union_find.h"
 
 
 /*
@@ -18,19 +22,60 @@
 *
 * Version information:
 *   2022-05-30: v1.0, first public version.
+*   2022-06-20: v1.1, nodes are looked up through a hash index.
+*   2022-06-21: v1.2, nodes have dense ids.
+*   2022-06-23: v1.3, added the neighbour iterator.
+*   2022-06-24: v1.4, edges store pointers to the destination nodes.
+*   2022-06-25: v1.5, seen status is an epoch stamp, reset in O(1).
+*   2022-06-26: v2.0, nodes, edges and names are allocated from an arena.
+*   2022-06-28: v2.1, connected components are kept in a union-find.
+*   2022-07-01: v2.2, nodes keep a list of in-edges.
+*   2022-07-09: v2.3, added graph_node_name().
+*   2022-07-10: v2.4, edges have weights.
+*   2022-07-13: v2.5, edge lists are doubly linked, so a node is deleted
+*               in time proportional to its degree.
+*   2022-07-14: v2.6, nodes can be named by pointer and length.
 */
-/*Defines a graph structure */
+/*Defines an edge cell. The out-edges of a node form a doubly linked list
+where dest is the destination, and the in-edges form one where dest is
+the source. An edge is a pair of adjacent cells, its out-edge cell
+followed by its in-edge cell, so each cell finds its twin without a
+search */
+typedef struct edge
+{
+        struct node *dest;
+        struct edge *next;
+        struct edge *prev;
+        double weight;
+} edge;
+/*Defines a graph structure. All nodes, edges and node names are allocated
+from the arena, and removed edges are kept in free_edges for reuse */
 typedef struct graph
 {
         int *node_max;
-        dlist *nodes;
+        arena *memory;
+        edge *free_edges;
+        int edges;
+        name_index *index;
+        //Nodes indexed by id, n nodes stored in room for by_id_size
+        node **by_id;
+        int n;
+        int by_id_size;
+        //A node is seen if its seen_epoch equals the current epoch
+        unsigned int epoch;
+        //Components over node ids, stale after a deletion until rebuilt
+        union_find *components;
+        bool components_stale;
 } graph;
-/*Defines a structure for the nodes */
+/*Defines a structure for the nodes. The neighbours list holds the
+out-edges of the node and in_neighbours the in-edges */
 typedef struct node
 {
         const char *identifier;
-        dlist *neighbours;
-        bool seen_status;
+        edge *neighbours;
+        edge *in_neighbours;
+        unsigned int seen_epoch;
+        int id;
 } node;
 /**
 * nodes_are_equal() - Check whether two nodes are equal.
@@ -50,15 +95,23 @@ bool nodes_are_equal(const node *n1, const node *n2)
 }
 /**
 * graph_empty() - Create an empty graph.
-* @max_nodes: The maximum number of nodes the graph can hold.
+* @max_nodes: The expected number of nodes, or 0 if unknown.
 *
 * Returns: A pointer to the new graph.
 */
 graph *graph_empty(int max_nodes)
 {     //Allocates memory for graph
         graph *g = calloc(1, sizeof(graph));
-        //Creates empty list for nodes
-        g->nodes = dlist_empty(NULL);
+        //Creates the arena, with a first block sized for the expected nodes
+        g->memory = arena_empty(max_nodes * (sizeof(node) + 16));
+        //Creates the name index, sized for the expected number of nodes
+        g->index = name_index_empty(max_nodes);
+        //Epoch 0 is never current, so new nodes are not seen
+        g->epoch = 1;
+        //Creates the id table, which grows as nodes are inserted
+        g->by_id_size = max_nodes > 0 ? max_nodes : 1;
+        g->by_id = malloc(g->by_id_size * sizeof(*g->by_id));
+        g->components = union_find_empty(max_nodes);
         return g;
 }
 /**
@@ -69,7 +122,7 @@ graph *graph_empty(int max_nodes)
 */
 bool graph_is_empty(const graph *g)
 {
-        return dlist_is_empty(g->nodes);
+        return g->n == 0;
 }
 /**
 * graph_has_edges() - Check if a graph has any edges.
@@ -78,19 +131,8 @@ bool graph_is_empty(const graph *g)
 * Returns: True if graph has any edges, otherwise false.
 */
 bool graph_has_edges(const graph *g)
-{     //Takes out first position in list
-        dlist_pos pos = dlist_first(g->nodes);
-        while (!dlist_is_end(g->nodes, pos))
-        {
-                node *inspected_node = dlist_inspect(g->nodes, pos);
-                if (!dlist_is_empty(inspected_node->neighbours))
-                {
-                        return 1;
-                }
-                //Updates position to next pos
-                pos = dlist_next(g->nodes, pos);
-        }
-        return 0;
+{     //The graph keeps count of its edges
+        return g->edges > 0;
 }
 /**
 * graph_insert_node() - Inserts a node with the given name into the graph.
@@ -98,18 +140,43 @@ bool graph_has_edges(const graph *g)
 * @s: Node name.
 *
 * Creates a new node with a copy of the given name and puts it into
-* the graph.
+* the graph. Both the node and the copy are allocated from the arena.
 *
 * Returns: The modified graph.
 */
 graph *graph_insert_node(graph *g, const char *s)
+{
+        return graph_insert_node_n(g, s, strlen(s));
+}
+/**
+* graph_insert_node_n() - Inserts a node named by a piece of a string.
+* @g: Graph to manipulate.
+* @s: First character of the name, which need not be terminated.
+* @length: Number of characters in the name.
+*
+* Returns: The modified graph.
+*/
+graph *graph_insert_node_n(graph *g, const char *s, int length)
 {     //Allocates memory for node and setting values
-        node *Node = calloc(1, sizeof(node) + sizeof(dlist *));
-        Node->identifier = s;
-        Node->neighbours = dlist_empty(NULL);
-        Node->seen_status = false;
+        node *Node = arena_alloc(g->memory, sizeof(node));
+        Node->identifier = arena_strndup(g->memory, s, length);
+        Node->neighbours = NULL;
+        Node->in_neighbours = NULL;
+        Node->seen_epoch = 0;
         //inserting set values into the graph
-        dlist_insert(g->nodes, Node, dlist_first(g->nodes));
+        g->index = name_index_insert(g->index, Node->identifier, Node);
+        //Gives the node the next free id
+        if (g->n == g->by_id_size)
+        {
+                g->by_id_size *= 2;
+                g->by_id = realloc(g->by_id, g->by_id_size * sizeof(*g->by_id));
+        }
+        Node->id = g->n;
+        g->by_id[g->n++] = Node;
+        if (!g->components_stale)
+        {
+                union_find_add(g->components);
+        }
         return g;
 }
 /**
@@ -121,20 +188,63 @@ graph *graph_insert_node(graph *g, const char *s)
 */
 node *graph_find_node(const graph *g, const char *s)
 {
-        dlist_pos pos = dlist_first(g->nodes);
-        while (!dlist_is_end(g->nodes, pos))
-        {
-                node *inspected_node = dlist_inspect(g->nodes, pos);
-                //If the inspected nodes identifier is the same as given string
-                if (!strcmp(inspected_node->identifier, s))
-                {
-                        //Returns the node
-                        return inspected_node;
-                }
-                pos = dlist_next(g->nodes, pos);
-        }
-        //If node is not found, returns NULL
-        return NULL;
+        //Returns NULL if node is not found
+        return name_index_lookup(g->index, s);
+}
+/**
+* graph_find_node_n() - Find a node named by a piece of a string.
+* @g: Graph to inspect.
+* @s: First character of the name, which need not be terminated.
+* @length: Number of characters in the name.
+*
+* Returns: A pointer to the found node, or NULL.
+*/
+node *graph_find_node_n(const graph *g, const char *s, int length)
+{
+        return name_index_lookup_n(g->index, s, length);
+}
+/**
+* graph_node_count() - Return the number of nodes in the graph.
+* @g: Graph to inspect.
+*
+* Returns: The number of nodes.
+*/
+int graph_node_count(const graph *g)
+{
+        return g->n;
+}
+/**
+* graph_node_id() - Return the dense id of a node.
+* @g: Graph storing the node.
+* @n: Node in the graph.
+*
+* Returns: The id of the node.
+*/
+int graph_node_id(const graph *g, const node *n)
+{
+        return n->id;
+}
+/**
+* graph_node_name() - Return the name of a node.
+* @g: Graph storing the node.
+* @n: Node in the graph.
+*
+* Returns: The graph's own copy of the name.
+*/
+const char *graph_node_name(const graph *g, const node *n)
+{
+        return n->identifier;
+}
+/**
+* graph_node_by_id() - Return the node with a given id.
+* @g: Graph to inspect.
+* @id: Node id in the range [0, graph_node_count()).
+*
+* Returns: A pointer to the node.
+*/
+node *graph_node_by_id(const graph *g, int id)
+{
+        return g->by_id[id];
 }
 /**
 * graph_node_is_seen() - Return the seen status for a node.
@@ -145,7 +255,7 @@ node *graph_find_node(const graph *g, const char *s)
 */
 bool graph_node_is_seen(const graph *g, const node *n)
 {
-        return n->seen_status;
+        return n->seen_epoch == g->epoch;
 }
 /**
 * graph_node_set_seen() - Set the seen status for a node.
@@ -156,28 +266,127 @@ bool graph_node_is_seen(const graph *g, const node *n)
 * Returns: The modified graph.
 */
 graph *graph_node_set_seen(graph *g, node *n, bool seen)
-{     //Sets seen_status to seen
-        n->seen_status = seen;
+{     //Stamps the node with the current epoch, or an epoch that is never current
+        n->seen_epoch = seen ? g->epoch : 0;
         return g;
 }
 /**
 * graph_reset_seen() - Reset the seen status on all nodes in the graph.
 * @g: Graph to modify.
 *
+* Starting a new epoch makes every stamp out of date, so this is O(1).
+* Only when the epoch counter wraps around are all stamps cleared.
+*
 * Returns: The modified graph.
 */
 graph *graph_reset_seen(graph *g)
 {
-        dlist_pos pos = dlist_first(g->nodes);
-        while (!dlist_is_end(g->nodes, pos))
+        g->epoch++;
+        if (g->epoch == 0)
         {
-                node *inspected_node = dlist_inspect(g->nodes, pos);
-                inspected_node->seen_status = false;
-                pos = dlist_next(g->nodes, pos);
+                for (int i = 0; i < g->n; i++)
+                {
+                        g->by_id[i]->seen_epoch = 0;
+                }
+                g->epoch = 1;
         }
         return g;
 }
 /**
+* new_edge() - Return an unused pair of edge cells.
+* @g: Graph to allocate the pair for.
+*
+* Reuses a removed pair if there is one, otherwise allocates one from
+* the arena.
+*
+* Returns: A pointer to the out-edge cell, the in-edge cell is the next one.
+*/
+static edge *new_edge(graph *g)
+{
+        edge *e = g->free_edges;
+        if (e != NULL)
+        {
+                g->free_edges = e->next;
+                return e;
+        }
+        return arena_alloc(g->memory, 2 * sizeof(edge));
+}
+/**
+* link_cell() - Insert a cell first in an edge list.
+* @list: Pointer to the head of the list.
+* @e: Cell to insert.
+*
+* Returns: Nothing.
+*/
+static void link_cell(edge **list, edge *e)
+{
+        e->prev = NULL;
+        e->next = *list;
+        if (*list != NULL)
+        {
+                (*list)->prev = e;
+        }
+        *list = e;
+}
+/**
+* unlink_cell() - Remove a cell from an edge list.
+* @list: Pointer to the head of the list.
+* @e: Cell in the list.
+*
+* Returns: Nothing.
+*/
+static void unlink_cell(edge **list, edge *e)
+{
+        if (e->prev != NULL)
+        {
+                e->prev->next = e->next;
+        }
+        else
+        {
+                *list = e->next;
+        }
+        if (e->next != NULL)
+        {
+                e->next->prev = e->prev;
+        }
+}
+/**
+* remove_edge() - Remove an edge from both of its lists.
+* @g: Graph owning the edge.
+* @src: Source node of the edge.
+* @e: Out-edge cell of the edge, in the list of src.
+*
+* The pair of cells is put on the free list.
+*
+* Returns: Nothing.
+*/
+static void remove_edge(graph *g, node *src, edge *e)
+{
+        unlink_cell(&src->neighbours, e);
+        unlink_cell(&e->dest->in_neighbours, e + 1);
+        e->next = g->free_edges;
+        g->free_edges = e;
+        g->edges--;
+}
+/**
+* find_edge() - Find the first out-edge cell to a given node.
+* @n1: Source node.
+* @n2: Destination node.
+*
+* Returns: The cell, or NULL if there is no edge from n1 to n2.
+*/
+static edge *find_edge(const node *n1, const node *n2)
+{
+        for (edge *e = n1->neighbours; e != NULL; e = e->next)
+        {
+                if (e->dest == n2)
+                {
+                        return e;
+                }
+        }
+        return NULL;
+}
+/**
 * graph_insert_edge() - Insert an edge into the graph.
 * @g: Graph to manipulate.
 * @n1: Source node (pointer) for the edge.
@@ -189,11 +398,35 @@ graph *graph_reset_seen(graph *g)
 */
 graph *graph_insert_edge(graph *g, node *n1, node *n2)
 {
-        // Get the neighbours of n1
-        dlist *n1_neighbours = n1->neighbours;
-        void *new_neighbour = (void *)n2->identifier;
-        // Insert (identifier of)n2 as a neighbour
-        dlist_insert(n1_neighbours, new_neighbour, dlist_first(n1_neighbours));
+        return graph_insert_weighted_edge(g, n1, n2, 1);
+}
+/**
+* graph_insert_weighted_edge() - Insert an edge with a weight into the graph.
+* @g: Graph to manipulate.
+* @n1: Source node (pointer) for the edge.
+* @n2: Destination node (pointer) for the edge.
+* @weight: Weight of the edge.
+*
+* NOTE: Undefined unless both nodes are already in the graph.
+*
+* Returns: The modified graph.
+*/
+graph *graph_insert_weighted_edge(graph *g, node *n1, node *n2, double weight)
+{
+        // Insert n2 first among the neighbours of n1
+        edge *e = new_edge(g);
+        e->dest = n2;
+        e->weight = weight;
+        link_cell(&n1->neighbours, e);
+        // And n1 first among the in-neighbours of n2, in the twin cell
+        e[1].dest = n1;
+        e[1].weight = weight;
+        link_cell(&n2->in_neighbours, &e[1]);
+        g->edges++;
+        if (!g->components_stale)
+        {
+                union_find_union(g->components, n1->id, n2->id);
+        }
         return g;
 }
 /**
@@ -201,27 +434,34 @@ graph *graph_insert_edge(graph *g, node *n1, node *n2)
 * @g: Graph to manipulate.
 * @n: Node to remove from the graph.
 *
+* Every edge to or from the node is removed through its twin cell, so the
+* time is proportional to the degree of the node. The node with the
+* highest id takes over the id of the removed node.
+*
 * Returns: The modified graph.
 *
 * NOTE: Undefined if the node is not in the graph.
 */
 graph *graph_delete_node(graph *g, node *n)
 {
-        dlist_pos pos = dlist_first(g->nodes);
-        while (!dlist_is_end(g->nodes, pos))
+        g->index = name_index_remove(g->index, n->identifier);
+        //Moves the last node into the freed id to keep ids dense
+        node *last = g->by_id[--g->n];
+        last->id = n->id;
+        g->by_id[last->id] = last;
+        //Removes the out-edges, then the in-edges through their out-edge cells
+        while (n->neighbours != NULL)
         {
-                node *inspected_node = dlist_inspect(g->nodes, pos);
-                //If the inspected node and given node are equal
-                if (nodes_are_equal(n, inspected_node))
-                {
-                        //Removes node from graph and frees.
-                        dlist_remove(g->nodes, pos);
-                        dlist_kill(inspected_node->neighbours);
-
-                        free(inspected_node);
-                        return g;
-                }
+                remove_edge(g, n, n->neighbours);
         }
+        while (n->in_neighbours != NULL)
+        {
+                edge *in = n->in_neighbours;
+                remove_edge(g, in->dest, in - 1);
+        }
+        //Sets can not be split, and the ids have changed
+        g->components_stale = true;
+        //The node itself stays in the arena until the graph is killed
         return g;
 }
 /**
@@ -236,34 +476,17 @@ graph *graph_delete_node(graph *g, node *n)
 */
 graph *graph_delete_edge(graph *g, node *n1, node *n2)
 {
-        const void *source = n1->identifier;
-        const void *destination = n2->identifier;
-        dlist_pos pos = dlist_first(g->nodes);
-        while (!dlist_is_end(g->nodes, pos))
+        //Only the out-edges of the source have to be searched, the
+        //in-edge cell is the twin of the out-edge cell
+        edge *e = find_edge(n1, n2);
+        if (e != NULL)
         {
-                node *inspected_node = dlist_inspect(g->nodes, pos);
-                //Compare strings of source and inspected nodes identifier
-                if (!strcmp(source, inspected_node->identifier))
-                {
-                        dlist_pos pos2 = dlist_first(inspected_node->neighbours);
-                        while (!dlist_is_end(inspected_node->neighbours, pos2))
-                        {
-                                void *inspected_identifier = dlist_inspect(inspected_node->neighbours, pos2);
-                                if (!strcmp(destination, inspected_identifier))
-                                {     //Removes inspected_nodes neighbours
-                                        dlist_remove(inspected_node->neighbours, pos2);
-                                        return g;
-                                }
-                                pos2 = dlist_next(inspected_node->neighbours, pos2);
-                        }
-                        //Prints out error message if given destination does not exist.
-                        printf("ERROR: Destination does not exist in the graph!\n");
-                        return NULL;
-                }
-                pos = dlist_next(g->nodes, pos);
+                remove_edge(g, n1, e);
+                g->components_stale = true;
+                return g;
         }
-        //Prints out error message if given source does not exist.
-        printf("ERROR: Source does not exist in the graph!\n");
+        //Prints out error message if given destination does not exist.
+        printf("ERROR: Destination does not exist in the graph!\n");
         return NULL;
 }
 /**
@@ -276,7 +499,93 @@ graph *graph_delete_edge(graph *g, node *n1, node *n2)
 */
 node *graph_choose_node(const graph *g)
 {
-        return dlist_inspect(g->nodes, dlist_first(g->nodes));
+        return g->by_id[0];
+}
+/**
+* graph_neighbour_first() - Return the first out-edge position of a node.
+* @g: Graph to inspect.
+* @n: Node to get neighbours for.
+*
+* The position holds the edge of the neighbour list of the node.
+*
+* Returns: The position of the first neighbour of the node.
+*/
+graph_pos graph_neighbour_first(const graph *g, const node *n)
+{
+        graph_pos p = { n, n->neighbours, 0 };
+        return p;
+}
+/**
+* graph_neighbour_is_end() - Check if a position is past the last neighbour.
+* @g: Graph to inspect.
+* @p: Any valid neighbour position.
+*
+* Returns: True if p is at the end of the neighbours.
+*/
+bool graph_neighbour_is_end(const graph *g, graph_pos p)
+{
+        return p.cell == NULL;
+}
+/**
+* graph_neighbour_inspect() - Return the neighbour at a position.
+* @g: Graph to inspect.
+* @p: Any valid neighbour position except the end.
+*
+* Returns: A pointer to the neighbour node.
+*/
+node *graph_neighbour_inspect(const graph *g, graph_pos p)
+{
+        return ((const edge *)p.cell)->dest;
+}
+/**
+* graph_neighbour_weight() - Return the weight of the edge at a position.
+* @g: Graph to inspect.
+* @p: Any valid out-neighbour position except the end.
+*
+* Returns: The weight of the edge to the neighbour at p.
+*/
+double graph_neighbour_weight(const graph *g, graph_pos p)
+{
+        return ((const edge *)p.cell)->weight;
+}
+/**
+* graph_neighbour_next() - Return the next neighbour position.
+* @g: Graph to inspect.
+* @p: Any valid neighbour position except the end.
+*
+* Returns: The position after p.
+*/
+graph_pos graph_neighbour_next(const graph *g, graph_pos p)
+{
+        p.cell = ((const edge *)p.cell)->next;
+        p.index++;
+        return p;
+}
+/**
+* graph_in_neighbour_first() - Return the first in-edge position of a node.
+* @g: Graph to inspect.
+* @n: Node to get in-neighbours for.
+*
+* The position holds the edge of the in-neighbour list of the node, so
+* graph_neighbour_is_end() and graph_neighbour_inspect() work unchanged.
+*
+* Returns: The position of the first in-neighbour of the node.
+*/
+graph_pos graph_in_neighbour_first(const graph *g, const node *n)
+{
+        graph_pos p = { n, n->in_neighbours, 0 };
+        return p;
+}
+/**
+* graph_in_neighbour_next() - Return the next in-neighbour position.
+* @g: Graph to inspect.
+* @p: Any valid in-neighbour position except the end.
+*
+* Returns: The position after p.
+*/
+graph_pos graph_in_neighbour_next(const graph *g, graph_pos p)
+{
+        return graph_neighbour_next(g, p);
 }
 /**
 * graph_neighbours() - Return a list of neighbour nodes.
@@ -289,37 +598,87 @@ node *graph_choose_node(const graph *g)
 dlist *graph_neighbours(const graph *g, const node *n)
 {     //Creates an empty list
         dlist *neighbours_copy = dlist_empty(NULL);
-        //Defines the list neighbours
-        dlist *neighbours = n->neighbours;
-        dlist_pos pos = dlist_first(neighbours);
-        while (!dlist_is_end(neighbours_copy, pos))
+        graph_pos pos = graph_neighbour_first(g, n);
+        while (!graph_neighbour_is_end(g, pos))
         {
-                node *n = graph_find_node(g, dlist_inspect(neighbours, pos));
+                node *n = graph_neighbour_inspect(g, pos);
                 //Inserting node n into neighbours_copy
                 dlist_insert(neighbours_copy, n, dlist_first(neighbours_copy));
-                pos = dlist_next(neighbours, pos);
+                pos = graph_neighbour_next(g, pos);
         }
         //returns the shallow copy
         return neighbours_copy;
 }
 /**
+* graph_union_neighbours() - Add the neighbours of a set of nodes to a set.
+* @g: Graph to inspect.
+* @frontier: Bitset over node ids of the nodes to expand.
+* @next: Bitset over node ids to add the neighbours to.
+*
+* Returns: Nothing.
+*/
+void graph_union_neighbours(const graph *g, const uint64_t *frontier,
+                            uint64_t *next)
+{
+        int words = bitset_words(g->n);
+        for (int i = bitset_next(frontier, words, 0); i >= 0;
+             i = bitset_next(frontier, words, i + 1))
+        {
+                graph_pos pos = graph_neighbour_first(g, g->by_id[i]);
+                while (!graph_neighbour_is_end(g, pos))
+                {
+                        bitset_set(next, graph_neighbour_inspect(g, pos)->id);
+                        pos = graph_neighbour_next(g, pos);
+                }
+        }
+}
+/**
+* graph_same_component() - Check if two nodes are in the same component.
+* @g: Graph to inspect.
+* @n1: First node.
+* @n2: Second node.
+*
+* If an edge or node has been deleted the union-find is first rebuilt
+* from all remaining edges.
+*
+* Returns: True if the nodes are in the same component, otherwise false.
+*/
+bool graph_same_component(graph *g, const node *n1, const node *n2)
+{
+        if (g->components_stale)
+        {
+                union_find_clear(g->components);
+                for (int i = 0; i < g->n; i++)
+                {
+                        union_find_add(g->components);
+                }
+                for (int i = 0; i < g->n; i++)
+                {
+                        for (edge *e = g->by_id[i]->neighbours; e != NULL; e = e->next)
+                        {
+                                union_find_union(g->components, i, e->dest->id);
+                        }
+                }
+                g->components_stale = false;
+        }
+        return union_find_same(g->components, n1->id, n2->id);
+}
+/**
 * graph_kill() - Destroy a given graph.
 * @g: Graph to destroy.
 *
-* Return all dynamic memory used by the graph.
+* Return all dynamic memory used by the graph. Since the nodes, edges and
+* names live in the arena this does not depend on the size of the graph.
 *
 * Returns: Nothing.
 */
 void graph_kill(graph *g)
 {
-        dlist *the_nodes = g->nodes;
-        while (!dlist_is_empty(the_nodes))
-        {
-                node *inspected_node = graph_choose_node(g);
-                g = graph_delete_node(g, inspected_node);
-        }
-        //Kills list and free memory used by graph
-        dlist_kill(the_nodes);
+        //Frees the arena and the tables used by the graph
+        arena_kill(g->memory);
+        name_index_kill(g->index);
+        free(g->by_id);
+        union_find_kill(g->components);
         free(g);
 }
 /**
@@ -332,14 +691,13 @@ void graph_kill(graph *g)
 */
 void graph_print(const graph *g)
 {
-        dlist_pos pos = dlist_first(g->nodes);
-        while (!dlist_is_end(g->nodes, pos))
+        for (int i = 0; i < g->n; i++)
         {     //Defines inspected node
-                node *inspected_node = dlist_inspect(g->nodes, pos);
+                node *inspected_node = g->by_id[i];
                 //Defines a list of neighbours
                 dlist *neighbours = graph_neighbours(g, inspected_node);//inspected_node->neighbours;
                 const char *identifier = inspected_node->identifier;
-                bool seenstatus = inspected_node->seen_status;
+                bool seenstatus = graph_node_is_seen(g, inspected_node);
                 dlist_pos pos2 = dlist_first(neighbours);
                 //Prints out identifier
                 printf("\nIdentifier: %s\n", identifier);
@@ -350,10 +708,10 @@ void graph_print(const graph *g)
                         node *tmpnode = dlist_inspect(neighbours, pos2);
                         const char *tmpstr = tmpnode->identifier;
                         printf("%s            \n            ", tmpstr);//(char *)dlist_inspect(neighbours, pos2));
-                        pos2 = dlist_next(g->nodes, pos2);
+                        pos2 = dlist_next(neighbours, pos2);
                 }
+                dlist_kill(neighbours);
                 //prints seen status
                 printf("\nSeenstatus: %d\n\n", seenstatus);
-                pos = dlist_next(g->nodes, pos);
         }
 }
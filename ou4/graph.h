@@ -2,6 +2,7 @@
 #define __GRAPH_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "util.h"
 #include "dlist.h"
 
@@ -11,8 +12,9 @@
  * University. The graph stores nodes and edges of a directed or
  * undirected graph. After use, the function graph_kill() must
  * be called to de-allocate the dynamic memory used by the graph
- * itself. The de-allocation of any dynamic memory allocated for the
- * node names is the responsibility of the user of the graph.
+ * itself. The graph stores its own copies of the node names, so any
+ * dynamic memory allocated for the names passed to the graph is the
+ * responsibility of the user and may be freed once the node is inserted.
  *
  * Author: Niclas Borlin (niclas.borlin@cs.umu.se)
  *
@@ -28,6 +30,25 @@
  *   v1.1  2019-03-06: Changed several const node * to node *.
  *                     Fixed doc bug to state that any dynamic memory allocated
  *                     to the node NAMES is the resposibility of the user.
+ *   v1.2  2022-06-21: Added dense node ids, graph_node_count(),
+ *                     graph_node_id() and graph_node_by_id().
+ *   v1.3  2022-06-22: Added graph_union_neighbours().
+ *   v1.4  2022-06-23: Added the neighbour iterator graph_neighbour_first(),
+ *                     graph_neighbour_is_end(), graph_neighbour_inspect()
+ *                     and graph_neighbour_next().
+ *   v1.5  2022-06-25: graph_reset_seen() is O(1).
+ *   v1.6  2022-06-26: The graph copies node names. graph_kill() does not
+ *                     depend on the size of the graph.
+ *   v1.7  2022-06-27: max_nodes in graph_empty() is only a size hint.
+ *   v1.8  2022-06-28: Added graph_same_component().
+ *   v1.9  2022-07-01: Added the in-neighbour iterator
+ *                     graph_in_neighbour_first() and graph_in_neighbour_next().
+ *   v2.0  2022-07-09: Added graph_node_name().
+ *   v2.1  2022-07-10: Added edge weights, graph_insert_weighted_edge() and
+ *                     graph_neighbour_weight().
+ *   v2.2  2022-07-13: graph_delete_node() removes the edges to the node
+ *                     and keeps the ids dense.
+ *   v2.3  2022-07-14: Added graph_insert_node_n() and graph_find_node_n().
  */
 
 // ====================== PUBLIC DATA TYPES ==========================
@@ -36,6 +57,15 @@
 typedef struct node node;
 typedef struct graph graph;
 
+// Position in the list of out-edges of a node. The fields are private to
+// the graph implementation, the type is only public so that positions can
+// be kept on the stack.
+typedef struct graph_pos {
+        const node *from;
+        void *cell;
+        int index;
+} graph_pos;
+
 // =================== NODE COMPARISON FUNCTION ======================
 
 /**
@@ -52,7 +82,8 @@ bool nodes_are_equal(const node *n1,const node *n2);
 
 /**
  * graph_empty() - Create an empty graph.
- * @max_nodes: The maximum number of nodes the graph can hold.
+ * @max_nodes: The expected number of nodes, or 0 if unknown. The graph
+ *             grows as needed when more nodes are inserted.
  *
  * Returns: A pointer to the new graph.
  */
@@ -86,6 +117,19 @@ bool graph_has_edges(const graph *g);
  */
 graph *graph_insert_node(graph *g, const char *s);
 
+/**
+ * graph_insert_node_n() - Inserts a node named by a piece of a string.
+ * @g: Graph to manipulate.
+ * @s: First character of the name, which need not be terminated.
+ * @length: Number of characters in the name.
+ *
+ * Like graph_insert_node(), but the name can point into a larger buffer,
+ * e.g. a mapped file.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_insert_node_n(graph *g, const char *s, int length);
+
 /**
  * graph_find_node() - Find a node stored in the graph.
  * @g: Graph to manipulate.
@@ -95,6 +139,55 @@ graph *graph_insert_node(graph *g, const char *s);
  */
 node *graph_find_node(const graph *g, const char *s);
 
+/**
+ * graph_find_node_n() - Find a node named by a piece of a string.
+ * @g: Graph to inspect.
+ * @s: First character of the name, which need not be terminated.
+ * @length: Number of characters in the name.
+ *
+ * Returns: A pointer to the found node, or NULL.
+ */
+node *graph_find_node_n(const graph *g, const char *s, int length);
+
+/**
+ * graph_node_count() - Return the number of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of nodes. Node ids are in the range [0, count).
+ */
+int graph_node_count(const graph *g);
+
+/**
+ * graph_node_id() - Return the dense id of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ *
+ * Node ids are dense, i.e. the nodes of a graph with N nodes have the
+ * ids 0..N-1. An id is stable until a node is deleted from the graph.
+ *
+ * Returns: The id of the node.
+ */
+int graph_node_id(const graph *g, const node *n);
+
+/**
+ * graph_node_name() - Return the name of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ *
+ * Returns: The graph's own copy of the name, valid until the node is
+ * deleted.
+ */
+const char *graph_node_name(const graph *g, const node *n);
+
+/**
+ * graph_node_by_id() - Return the node with a given id.
+ * @g: Graph to inspect.
+ * @id: Node id in the range [0, graph_node_count()).
+ *
+ * Returns: A pointer to the node.
+ */
+node *graph_node_by_id(const graph *g, int id);
+
 /**
  * graph_node_is_seen() - Return the seen status for a node.
  * @g: Graph storing the node.
@@ -118,6 +211,8 @@ graph *graph_node_set_seen(graph *g, node *n, bool seen);
  * graph_reset_seen() - Reset the seen status on all nodes in the graph.
  * @g: Graph to modify.
  *
+ * The reset takes constant time, independent of the number of nodes.
+ *
  * Returns: The modified graph.
  */
 graph *graph_reset_seen(graph *g);
@@ -134,11 +229,30 @@ graph *graph_reset_seen(graph *g);
  */
 graph *graph_insert_edge(graph *g, node *n1, node *n2);
 
+/**
+ * graph_insert_weighted_edge() - Insert an edge with a weight into the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ * @weight: Weight of the edge, e.g. a distance or a cost.
+ *
+ * graph_insert_edge() gives the edge the weight 1.
+ *
+ * NOTE: Undefined unless both nodes are already in the graph.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_insert_weighted_edge(graph *g, node *n1, node *n2, double weight);
+
 /**
  * graph_delete_node() - Remove a node from the graph.
  * @g: Graph to manipulate.
  * @n: Node to remove from the graph.
  *
+ * All edges to and from the node are removed as well. The node with the
+ * highest id takes over the id of the removed node, so the ids are still
+ * in the range [0, graph_node_count()).
+ *
  * Returns: The modified graph.
  *
  * NOTE: Undefined if the node is not in the graph.
@@ -173,10 +287,115 @@ node *graph_choose_node(const graph *g);
  * @n: Node to get neighbours for.
  *
  * Returns: A pointer to a list of nodes. Note: The list must be
- * dlist_kill()-ed after use.
+ * dlist_kill()-ed after use. Use the neighbour iterator to avoid
+ * allocating the list.
  */
 dlist *graph_neighbours(const graph *g,const node *n);
 
+/**
+ * graph_neighbour_first() - Return the first out-edge position of a node.
+ * @g: Graph to inspect.
+ * @n: Node to get neighbours for.
+ *
+ * Iterating over the neighbours with graph_neighbour_first(),
+ * graph_neighbour_is_end(), graph_neighbour_inspect() and
+ * graph_neighbour_next() does not allocate any memory. The positions
+ * are invalidated if the edges of the node are changed.
+ *
+ * Returns: The position of the first neighbour of the node.
+ */
+graph_pos graph_neighbour_first(const graph *g, const node *n);
+
+/**
+ * graph_neighbour_is_end() - Check if a position is past the last neighbour.
+ * @g: Graph to inspect.
+ * @p: Any valid neighbour position.
+ *
+ * Returns: True if p is at the end of the neighbours.
+ */
+bool graph_neighbour_is_end(const graph *g, graph_pos p);
+
+/**
+ * graph_neighbour_inspect() - Return the neighbour at a position.
+ * @g: Graph to inspect.
+ * @p: Any valid neighbour position except the end.
+ *
+ * Returns: A pointer to the neighbour node.
+ */
+node *graph_neighbour_inspect(const graph *g, graph_pos p);
+
+/**
+ * graph_neighbour_next() - Return the next neighbour position.
+ * @g: Graph to inspect.
+ * @p: Any valid neighbour position except the end.
+ *
+ * Returns: The position after p.
+ */
+graph_pos graph_neighbour_next(const graph *g, graph_pos p);
+
+/**
+ * graph_neighbour_weight() - Return the weight of the edge at a position.
+ * @g: Graph to inspect.
+ * @p: Any valid out-neighbour position except the end.
+ *
+ * Returns: The weight of the edge to the neighbour at p.
+ */
+double graph_neighbour_weight(const graph *g, graph_pos p);
+
+/**
+ * graph_in_neighbour_first() - Return the first in-edge position of a node.
+ * @g: Graph to inspect.
+ * @n: Node to get in-neighbours for.
+ *
+ * The in-neighbours of n are the nodes with an edge to n. Positions
+ * returned by graph_in_neighbour_first() are advanced with
+ * graph_in_neighbour_next() and checked with graph_neighbour_is_end()
+ * and graph_neighbour_inspect().
+ *
+ * Returns: The position of the first in-neighbour of the node.
+ */
+graph_pos graph_in_neighbour_first(const graph *g, const node *n);
+
+/**
+ * graph_in_neighbour_next() - Return the next in-neighbour position.
+ * @g: Graph to inspect.
+ * @p: Any valid in-neighbour position except the end.
+ *
+ * Returns: The position after p.
+ */
+graph_pos graph_in_neighbour_next(const graph *g, graph_pos p);
+
+/**
+ * graph_union_neighbours() - Add the neighbours of a set of nodes to a set.
+ * @g: Graph to inspect.
+ * @frontier: Bitset (see bitset.h) over node ids of the nodes to expand.
+ * @next: Bitset over node ids to add the neighbours to.
+ *
+ * Both bitsets must hold at least graph_node_count() bits. This is one
+ * level of a breadth-first search over bitset frontiers.
+ *
+ * Returns: Nothing.
+ */
+void graph_union_neighbours(const graph *g, const uint64_t *frontier,
+                            uint64_t *next);
+
+/**
+ * graph_same_component() - Check if two nodes are in the same component.
+ * @g: Graph to inspect.
+ * @n1: First node.
+ * @n2: Second node.
+ *
+ * The components are those of the graph with the edge directions
+ * ignored. They are kept in a union-find structure that is updated as
+ * edges are inserted, so the check is nearly O(1). After a deletion the
+ * structure is rebuilt once, on the next call. For an undirected graph
+ * (every edge inserted in both directions) this answers whether there is
+ * a path between the nodes.
+ *
+ * Returns: True if the nodes are in the same component, otherwise false.
+ */
+bool graph_same_component(graph *g, const node *n1, const node *n2);
+
 /**
  * graph_kill() - Destroy a given graph.
  * @g: Graph to destroy.
@@ -2,10 +2,15 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "graph.h"
 #include "dlist.h"
 #include "array_1d.h"
+#include "name_index.h"
+#include "bitset.h"
+#include "arena.h"
+#include "union_find.h"
 
 /*
  * Implementation of a generic graph/1D-array solution for the "Datastructures and
@@ -19,8 +24,26 @@
  * Version information:
  *   2021-05-18: v1.0, first public version.
  *   2021-03-06: v2.0, second public version.
+ *   2022-06-20: v2.1, nodes are looked up through a hash index.
+ *   2022-06-21: v2.2, nodes have dense ids.
+ *   2022-06-22: v3.0, the adjacency matrix rows are packed bitsets.
+ *   2022-06-23: v3.1, added the neighbour iterator.
+ *   2022-06-25: v3.2, seen status is an epoch stamp, reset in O(1).
+ *   2022-06-26: v3.3, nodes and names are allocated from an arena.
+ *   2022-06-27: v3.4, the matrix grows as nodes are inserted.
+ *   2022-06-28: v3.5, connected components are kept in a union-find.
+ *   2022-07-01: v3.6, added the in-neighbour iterator.
+ *   2022-07-09: v3.7, added graph_node_name().
+ *   2022-07-10: v3.8, edges have weights, kept in a second matrix once
+ *               an edge weight other than 1 is inserted.
+ *   2022-07-13: v3.9, deleting a node removes its column too, and the
+ *               last node moves into its id so the ids stay dense.
+ *   2022-07-14: v3.10, nodes can be named by pointer and length.
  */
 
+// Node capacity of a graph created without a size hint.
+#define MIN_NODES 16
+
 #define lo1 0
 #define lo2 0
 #define hi1 10
@@ -36,22 +59,99 @@ struct array_1d {
 	free_function free_func;
 };
 
+// The adjacency matrix is stored row by row in one block, where row i is
+// a bitset over the node ids of the neighbours of node i. There is room
+// for node_max nodes, and the capacity is doubled when it runs out.
 typedef struct graph
 {
         int node_max;
         int n;
         array_1d *nodes;
+        name_index *index;
+        int words;
+        uint64_t *rows;
+        arena *memory; // Holds the nodes and copies of their names.
+        unsigned int epoch; // A node is seen if stamped with this epoch.
+        union_find *components; // Components over node ids.
+        bool components_stale; // Set by deletions, cleared by a rebuild.
+        double *weights; // node_max x node_max edge weights, NULL while all are 1.
 } graph;
 
 typedef struct node
 {
-        array_1d *neighbours;
         const char *identifier;
-        bool seen_status;
+        unsigned int seen_epoch;
+        int id;
 } node;
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
 
+/**
+ * new_weights() - Allocate a weight matrix with every weight set to 1.
+ * @node_max: Number of rows and columns.
+ *
+ * Returns: A pointer to the matrix, stored row by row.
+ */
+static double *new_weights(int node_max) {
+        size_t cells = (size_t)node_max * node_max;
+        double *weights = malloc((cells > 0 ? cells : 1) * sizeof(*weights));
+        for(size_t i = 0; i < cells; i++) {
+                weights[i] = 1;
+        }
+        return weights;
+}
+
+/**
+ * grow() - Double the node capacity of the graph.
+ * @g: Graph to manipulate.
+ *
+ * Copies the node array and every row into larger ones. Since the
+ * capacity doubles, the copying costs amortized O(1) per matrix cell.
+ *
+ * Returns: Nothing.
+ */
+static void grow(graph *g) {
+        int node_max = 2 * g->node_max;
+        int words = bitset_words(node_max);
+		// Move the node pointers to a larger array.
+        array_1d *nodes = array_1d_create(0, node_max, NULL);
+        for(int i = 0; i < g->n; i++) {
+                array_1d_set_value(nodes, array_1d_inspect_value(g->nodes, i), i);
+        }
+        array_1d_kill(g->nodes);
+		// Copy each row to the start of its wider, cleared row.
+        uint64_t *rows = calloc((size_t)node_max * words + 1, sizeof(*rows));
+        for(int i = 0; i < g->n; i++) {
+                memcpy(rows + (size_t)i * words, g->rows + (size_t)i * g->words,
+                       g->words * sizeof(*rows));
+        }
+        free(g->rows);
+        if(g->weights != NULL) {
+                double *weights = new_weights(node_max);
+                for(int i = 0; i < g->n; i++) {
+                        memcpy(weights + (size_t)i * node_max, g->weights + (size_t)i * g->node_max,
+                               g->n * sizeof(*weights));
+                }
+                free(g->weights);
+                g->weights = weights;
+        }
+        g->nodes = nodes;
+        g->rows = rows;
+        g->words = words;
+        g->node_max = node_max;
+}
+
+/**
+ * row() - Return the adjacency row of a node.
+ * @g: Graph storing the node.
+ * @id: Id of the node.
+ *
+ * Returns: A pointer to the first word of the row.
+ */
+static uint64_t *row(const graph *g, int id) {
+        return g->rows + (size_t)id * g->words;
+}
+
 /**
 * nodes_are_equal() - Check whether two nodes are equal.
 * @n1: Pointer to node 1.
@@ -69,17 +169,31 @@ bool nodes_are_equal(const node *n1, const node *n2)
 
 /**
  * graph_empty() - Create an empty graph.
- * @max_nodes: The maximum number of nodes the graph can hold.
+ * @max_nodes: The expected number of nodes, or 0 if unknown. The graph
+ *             grows beyond it if needed.
  *
  * Returns: A pointer to the new graph.
  */
 graph *graph_empty(int max_nodes) {
+        if(max_nodes < MIN_NODES) {
+                max_nodes = MIN_NODES;
+        }
 		// Allocates memory for graph.
         graph *g = calloc(1, sizeof(graph));
 		// Creates an empty array for nodes.
         g->nodes = array_1d_create(0, max_nodes, NULL);
         g->n = 0;
         g->node_max = max_nodes;
+        g->memory = arena_empty(0);
+		// Epoch 0 is never current, so new nodes are not seen.
+        g->epoch = 1;
+		// Allocates the cleared adjacency matrix.
+        g->words = bitset_words(max_nodes);
+        g->rows = calloc((size_t)max_nodes * g->words + 1, sizeof(*g->rows));
+		// Creates the name index.
+        g->index = name_index_empty(max_nodes);
+		// Creates the components, one set per node.
+        g->components = union_find_empty(max_nodes);
         return g;
 }
 
@@ -100,20 +214,8 @@ bool graph_is_empty(const graph *g) {
  * Returns: True if graph has any edges, otherwise false.
  */
 bool graph_has_edges(const graph *g) {
-        array_1d *arr = g->nodes;
-		// Loop over all rows and cols.
-        for(int r = 0; r < g->n; r++) {
-				// Inspect nodes
-                node *n = array_1d_inspect_value(arr, r);
-				// Check neighbours.
-                array_1d *neighbours = n->neighbours;
-                for(int c = 0; c < g->n; c++) {
-                        if(*(int*)array_1d_inspect_value(neighbours, c)) {
-                                return 1;
-                        }
-                }
-        }
-        return 0;
+		// Any set bit in any row is an edge.
+        return bitset_any(g->rows, g->n * g->words);
 }
 
 /**
@@ -127,24 +229,36 @@ bool graph_has_edges(const graph *g) {
  * Returns: The modified graph.
  */
 graph *graph_insert_node(graph *g, const char *s) {
-		// Allocate memory for node.
-        node *n = calloc(1,sizeof(node)+sizeof(array_1d*));
-		// Set node name in node identifier.
-		n->identifier = s;
-		// Create empty neighbours graph.
-        n->neighbours = array_1d_create(0, g->node_max, NULL);
-		// Iterate over graph.
-        for(int i = 0; i <= g->node_max; i++) {
-				// Allocate memory for neighbours.
-                int *nb = malloc(sizeof(nb));
-                *nb = 0;
-				// Set neighbours.
-                array_1d_set_value(n->neighbours, nb, i);
+        return graph_insert_node_n(g, s, strlen(s));
+}
+
+/**
+ * graph_insert_node_n() - Inserts a node named by a piece of a string.
+ * @g: Graph to manipulate.
+ * @s: First character of the name, which need not be terminated.
+ * @length: Number of characters in the name.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_insert_node_n(graph *g, const char *s, int length) {
+		// Make room for one more node.
+        if(g->n == g->node_max) {
+                grow(g);
         }
-        n->seen_status = 0;
+		// Allocate memory for node from the arena.
+        node *n = arena_alloc(g->memory, sizeof(node));
+		// Set a copy of the node name as node identifier.
+		n->identifier = arena_strndup(g->memory, s, length);
+        n->seen_epoch = 0;
+		// The id is the position in the node array, its row is already cleared.
+        n->id = g->n;
 		// Set nodes.
         array_1d_set_value(g->nodes, n, g->n);
+        g->index = name_index_insert(g->index, n->identifier, n);
         g->n++;
+        if(!g->components_stale) {
+                union_find_add(g->components);
+        }
         return g;
 }
 
@@ -156,17 +270,63 @@ graph *graph_insert_node(graph *g, const char *s) {
  * Returns: A pointer to the found node, or NULL.
  */
 node *graph_find_node(const graph *g, const char *s) {
-        array_1d *nodes = g->nodes;
-		// Iterate to find and store node.
-        for(int i = 0; i < g->n; i++) {
-                node *n = array_1d_inspect_value(nodes, i);
-                const char *identifier = n->identifier;
-				// If true return n.
-                if(!strcmp(s, identifier)) {
-                        return n;
-                }
-        }
-        return NULL;
+		// Look up node in the name index, NULL if missing.
+        return name_index_lookup(g->index, s);
+}
+
+/**
+ * graph_find_node_n() - Find a node named by a piece of a string.
+ * @g: Graph to inspect.
+ * @s: First character of the name, which need not be terminated.
+ * @length: Number of characters in the name.
+ *
+ * Returns: A pointer to the found node, or NULL.
+ */
+node *graph_find_node_n(const graph *g, const char *s, int length) {
+        return name_index_lookup_n(g->index, s, length);
+}
+
+/**
+ * graph_node_count() - Return the number of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of nodes.
+ */
+int graph_node_count(const graph *g) {
+        return g->n;
+}
+
+/**
+ * graph_node_id() - Return the dense id of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ *
+ * Returns: The id of the node.
+ */
+int graph_node_id(const graph *g, const node *n) {
+        return n->id;
+}
+
+/**
+ * graph_node_name() - Return the name of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ *
+ * Returns: The graph's own copy of the name.
+ */
+const char *graph_node_name(const graph *g, const node *n) {
+        return n->identifier;
+}
+
+/**
+ * graph_node_by_id() - Return the node with a given id.
+ * @g: Graph to inspect.
+ * @id: Node id in the range [0, graph_node_count()).
+ *
+ * Returns: A pointer to the node.
+ */
+node *graph_node_by_id(const graph *g, int id) {
+        return array_1d_inspect_value(g->nodes, id);
 }
 
 /**
@@ -177,7 +337,7 @@ node *graph_find_node(const graph *g, const char *s) {
  * Returns: The seen status for the node.
  */
 bool graph_node_is_seen(const graph *g, const node *n) {
-        return n->seen_status;
+        return n->seen_epoch == g->epoch;
 }
 
 /**
@@ -189,8 +349,8 @@ bool graph_node_is_seen(const graph *g, const node *n) {
  * Returns: The modified graph.
  */
 graph *graph_node_set_seen(graph *g, node *n, bool seen) {
-		// Set seen status.
-        n->seen_status = seen;
+		// Stamp with the current epoch, or one that is never current.
+        n->seen_epoch = seen ? g->epoch : 0;
 		// Return graph.
         return g;
 }
@@ -199,14 +359,21 @@ graph *graph_node_set_seen(graph *g, node *n, bool seen) {
  * graph_reset_seen() - Reset the seen status on all nodes in the graph.
  * @g: Graph to modify.
  *
+ * Starting a new epoch makes every stamp out of date, so this is O(1).
+ * Only when the epoch counter wraps around are all stamps cleared.
+ *
  * Returns: The modified graph.
  */
 graph *graph_reset_seen(graph *g) {
-        array_1d *nodes = g->nodes;
-		// Iterate over nodes to reset seen status.
-        for(int r = array_1d_low(g->nodes); r < g->n; r++) {
-                node *n = array_1d_inspect_value(nodes, r);
-                n->seen_status = 0;
+        g->epoch++;
+        if(g->epoch == 0) {
+                array_1d *nodes = g->nodes;
+		// Iterate over nodes to clear the stamps of the old epochs.
+                for(int r = array_1d_low(g->nodes); r < g->n; r++) {
+                        node *n = array_1d_inspect_value(nodes, r);
+                        n->seen_epoch = 0;
+                }
+                g->epoch = 1;
         }
         return g;
 }
@@ -222,50 +389,127 @@ graph *graph_reset_seen(graph *g) {
  * Returns: The modified graph.
  */
 graph *graph_insert_edge(graph *g, node *n1, node *n2) {
-        array_1d *nodes = g->nodes;
-        int srcidx, destidx;
-		// Iterate to find and insert edges.
-        for(int i = 0; i < g->n; i++) {
-                node *n = array_1d_inspect_value(nodes, i);
-				// If equal set source.
-                if(nodes_are_equal(n1,n)) {
-                        srcidx = i;
-                }
-				// If equal set destination.
-                if(nodes_are_equal(n2,n)) {
-                        destidx = i;
+        return graph_insert_weighted_edge(g, n1, n2, 1);
+}
+
+/**
+ * graph_insert_weighted_edge() - Insert an edge with a weight into the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ * @weight: Weight of the edge.
+ *
+ * The matrix holds one edge per pair of nodes, so inserting an edge again
+ * keeps the lower of the two weights, as a route would take the cheaper
+ * of two parallel edges.
+ *
+ * NOTE: Undefined unless both nodes are already in the graph.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_insert_weighted_edge(graph *g, node *n1, node *n2, double weight) {
+        size_t cell = (size_t)n1->id * g->node_max + n2->id;
+		// A repeated edge keeps the cheaper weight.
+        if(bitset_test(row(g, n1->id), n2->id)) {
+                double old = g->weights != NULL ? g->weights[cell] : 1;
+                if(old < weight) {
+                        weight = old;
                 }
         }
-		// Inspect value for specifik source.
-        node *changeNode = array_1d_inspect_value(nodes, srcidx);
-		// Set neighbours.
-        array_1d *neighbours = changeNode->neighbours;
-		// Inspect nodes for specifik destination.
-        int *val = array_1d_inspect_value(neighbours, destidx);
-        *val = 1;
+		// Set the bit for the destination in the row of the source.
+        bitset_set(row(g, n1->id), n2->id);
+		// The weight matrix is only needed once a weight is not 1.
+        if(g->weights == NULL && weight != 1) {
+                g->weights = new_weights(g->node_max);
+        }
+        if(g->weights != NULL) {
+                g->weights[cell] = weight;
+        }
+        if(!g->components_stale) {
+                union_find_union(g->components, n1->id, n2->id);
+        }
         return g;
 }
 
+/**
+ * move_weights() - Move the weights of the last node to another id.
+ * @g: Graph to manipulate, with a weight matrix.
+ * @id: Id to move the weights to.
+ * @last: Id of the last node.
+ *
+ * Returns: Nothing.
+ */
+static void move_weights(graph *g, int id, int last) {
+		// Move the column first, so a loop at last ends up in the row too.
+        for(int i = 0; i <= last; i++) {
+                g->weights[(size_t)i * g->node_max + id] = g->weights[(size_t)i * g->node_max + last];
+        }
+        memcpy(g->weights + (size_t)id * g->node_max, g->weights + (size_t)last * g->node_max,
+               (last + 1) * sizeof(*g->weights));
+}
+
 /**
  * graph_delete_node() - Remove a node from the graph.
  * @g: Graph to manipulate.
  * @n: Node to remove from the graph.
  *
+ * The row and column of the node are cleared, and the node with the
+ * highest id takes over its id by moving its row and column there. That
+ * touches one bit per row instead of rebuilding the matrix, and the ids
+ * stay equal to the rows, so the rows are still bitsets over node ids.
+ *
  * Returns: The modified graph.
  *
  * NOTE: Undefined if the node is not in the graph.
  */
 graph *graph_delete_node(graph *g, node *n) {
-        array_1d *myneighbours = n->neighbours;
-		// Iterate over graph to free memory.
-        for(int i = 0; i <= g->node_max; i++) {
-                int *temp = array_1d_inspect_value(myneighbours, i);
-                free(temp);
+        int id = n->id;
+        int last = g->n - 1;
+		// Clear the edges from the node.
+        bitset_clear(row(g, id), g->words);
+		// Clear the edges to the node, and move those to the last node.
+        for(int i = 0; i <= last; i++) {
+                uint64_t *r = row(g, i);
+                bitset_unset(r, id);
+                if(id != last && bitset_test(r, last)) {
+                        bitset_unset(r, last);
+                        bitset_set(r, id);
+                }
         }
-		// Kill and free memory.
-        array_1d_kill(myneighbours);
-        free(n);
-        //g->n--;
+        if(id != last) {
+		// Move the row of the last node, then clear it for the next node.
+                memcpy(row(g, id), row(g, last), g->words * sizeof(*g->rows));
+                bitset_clear(row(g, last), g->words);
+                if(g->weights != NULL) {
+                        move_weights(g, id, last);
+                }
+                node *moved = array_1d_inspect_value(g->nodes, last);
+                moved->id = id;
+                array_1d_set_value(g->nodes, moved, id);
+        }
+        array_1d_set_value(g->nodes, NULL, last);
+        g->n--;
+		// The node memory is returned with the arena.
+        g->index = name_index_remove(g->index, n->identifier);
+		// Sets can not be split, so the components are rebuilt when needed.
+        g->components_stale = true;
+        return g;
+}
+
+/**
+ * graph_delete_edge() - Remove an edge from the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * Returns: The modified graph.
+ *
+ * NOTE: Undefined if the edge is not in the graph.
+ */
+graph *graph_delete_edge(graph *g, node *n1, node *n2) {
+		// Clear the bit for the destination in the row of the source.
+        bitset_unset(row(g, n1->id), n2->id);
+        g->components_stale = true;
         return g;
 }
 
@@ -284,6 +528,116 @@ node *graph_choose_node(const graph *g) {
         return n;
 }
 
+/**
+ * graph_neighbour_first() - Return the first out-edge position of a node.
+ * @g: Graph to inspect.
+ * @n: Node to get neighbours for.
+ *
+ * The position holds the id of the neighbour, i.e. the bit in the row.
+ *
+ * Returns: The position of the first neighbour of the node.
+ */
+graph_pos graph_neighbour_first(const graph *g, const node *n) {
+        graph_pos p = { n, NULL, bitset_next(row(g, n->id), g->words, 0) };
+        return p;
+}
+
+/**
+ * graph_neighbour_is_end() - Check if a position is past the last neighbour.
+ * @g: Graph to inspect.
+ * @p: Any valid neighbour position.
+ *
+ * Returns: True if p is at the end of the neighbours.
+ */
+bool graph_neighbour_is_end(const graph *g, graph_pos p) {
+        return p.index < 0;
+}
+
+/**
+ * graph_neighbour_inspect() - Return the neighbour at a position.
+ * @g: Graph to inspect.
+ * @p: Any valid neighbour position except the end.
+ *
+ * Returns: A pointer to the neighbour node.
+ */
+node *graph_neighbour_inspect(const graph *g, graph_pos p) {
+        return array_1d_inspect_value(g->nodes, p.index);
+}
+
+/**
+ * graph_neighbour_weight() - Return the weight of the edge at a position.
+ * @g: Graph to inspect.
+ * @p: Any valid out-neighbour position except the end.
+ *
+ * Returns: The weight of the edge to the neighbour at p.
+ */
+double graph_neighbour_weight(const graph *g, graph_pos p) {
+        if(g->weights == NULL) {
+                return 1;
+        }
+        return g->weights[(size_t)p.from->id * g->node_max + p.index];
+}
+
+/**
+ * graph_neighbour_next() - Return the next neighbour position.
+ * @g: Graph to inspect.
+ * @p: Any valid neighbour position except the end.
+ *
+ * Returns: The position after p.
+ */
+graph_pos graph_neighbour_next(const graph *g, graph_pos p) {
+		// Jump to the next set bit of the row.
+        p.index = bitset_next(row(g, p.from->id), g->words, p.index + 1);
+        return p;
+}
+
+/**
+ * column_next() - Find the next node with an edge to a node.
+ * @g: Graph to inspect.
+ * @id: Id of the destination node.
+ * @from: First source id to consider.
+ *
+ * Returns: The id of the first source >= from with an edge to id, or -1
+ * if there is none.
+ */
+static int column_next(const graph *g, int id, int from) {
+		// The column is spread over the rows, so test one bit per row.
+        for(int i = from; i < g->n; i++) {
+                if(bitset_test(row(g, i), id)) {
+                        return i;
+                }
+        }
+        return -1;
+}
+
+/**
+ * graph_in_neighbour_first() - Return the first in-edge position of a node.
+ * @g: Graph to inspect.
+ * @n: Node to get in-neighbours for.
+ *
+ * The position holds the id of the in-neighbour, i.e. the row with the
+ * bit of n set. Finding the in-neighbours scans the column of n, so a
+ * full iteration takes O(N) time.
+ *
+ * Returns: The position of the first in-neighbour of the node.
+ */
+graph_pos graph_in_neighbour_first(const graph *g, const node *n) {
+        graph_pos p = { n, NULL, column_next(g, n->id, 0) };
+        return p;
+}
+
+/**
+ * graph_in_neighbour_next() - Return the next in-neighbour position.
+ * @g: Graph to inspect.
+ * @p: Any valid in-neighbour position except the end.
+ *
+ * Returns: The position after p.
+ */
+graph_pos graph_in_neighbour_next(const graph *g, graph_pos p) {
+        p.index = column_next(g, p.from->id, p.index + 1);
+        return p;
+}
+
 /**
  * graph_neighbours() - Return a list of neighbour nodes.
  * @g: Graph to inspect.
@@ -295,19 +649,62 @@ node *graph_choose_node(const graph *g) {
 dlist *graph_neighbours(const graph *g, const node *n) {
 		// Create an empty list.
         dlist *neighboursCopy = dlist_empty(NULL);
-        array_1d *neighbourarr = n->neighbours;
-        array_1d *nodes = g->nodes;
-		// Iterate over graph.
-        for(int i = 0; i < g->n; i++) {
-				// If true inspect value and insert into list
-                if(*(int*)array_1d_inspect_value(neighbourarr,i)) {
-                        node *n = array_1d_inspect_value(nodes, i);
-                        dlist_insert(neighboursCopy, n, dlist_first(neighboursCopy));
-                }
+		// Iterate over the neighbours.
+        for(graph_pos p = graph_neighbour_first(g, n);
+            !graph_neighbour_is_end(g, p); p = graph_neighbour_next(g, p)) {
+                node *n = graph_neighbour_inspect(g, p);
+                dlist_insert(neighboursCopy, n, dlist_first(neighboursCopy));
         }
         return neighboursCopy;
 }
 
+/**
+ * graph_union_neighbours() - Add the neighbours of a set of nodes to a set.
+ * @g: Graph to inspect.
+ * @frontier: Bitset over node ids of the nodes to expand.
+ * @next: Bitset over node ids to add the neighbours to.
+ *
+ * Returns: Nothing.
+ */
+void graph_union_neighbours(const graph *g, const uint64_t *frontier,
+                            uint64_t *next) {
+        int words = bitset_words(g->n);
+		// OR the used part of the row of every frontier node into next.
+        for(int i = bitset_next(frontier, words, 0); i >= 0;
+            i = bitset_next(frontier, words, i + 1)) {
+                bitset_or(next, row(g, i), words);
+        }
+}
+
+/**
+ * graph_same_component() - Check if two nodes are in the same component.
+ * @g: Graph to inspect.
+ * @n1: First node.
+ * @n2: Second node.
+ *
+ * If an edge or node has been deleted the union-find is first rebuilt
+ * from the set bits of the matrix.
+ *
+ * Returns: True if the nodes are in the same component, otherwise false.
+ */
+bool graph_same_component(graph *g, const node *n1, const node *n2) {
+        if(g->components_stale) {
+                int words = bitset_words(g->n);
+                union_find_clear(g->components);
+                for(int i = 0; i < g->n; i++) {
+                        union_find_add(g->components);
+                }
+                for(int i = 0; i < g->n; i++) {
+                        for(int j = bitset_next(row(g, i), words, 0); j >= 0;
+                            j = bitset_next(row(g, i), words, j + 1)) {
+                                union_find_union(g->components, i, j);
+                        }
+                }
+                g->components_stale = false;
+        }
+        return union_find_same(g->components, n1->id, n2->id);
+}
+
 /**
  * graph_kill() - Destroy a given graph.
  * @g: Graph to destroy.
@@ -317,15 +714,14 @@ dlist *graph_neighbours(const graph *g, const node *n) {
  * Returns: Nothing.
  */
 void graph_kill(graph *g) {
-        array_1d *nodes = g->nodes;
-		// Iterate over graph.
-        for(int i = 0; i < g->n; i++) {
-				// Inspect all nodes and delete.
-                node *inspectedNode = array_1d_inspect_value(nodes, i);
-                g = graph_delete_node(g, inspectedNode);
-        }
+		// The nodes live in the arena, so no per-node work is needed.
+        arena_kill(g->memory);
 		// Kill nodes and free graph.
-        array_1d_kill(nodes);
+        array_1d_kill(g->nodes);
+        free(g->rows);
+        free(g->weights);
+        name_index_kill(g->index);
+        union_find_kill(g->components);
         free(g);
 
 }
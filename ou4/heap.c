@@ -0,0 +1,238 @@
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "heap.h"
+
+/*
+* Implementation of an indexed 4-ary min-heap. The tree is stored in an
+* array where the children of slot i are the slots 4i+1 to 4i+4, and pos
+* maps every id to its slot, or to NONE if the id is not in the heap.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-07-10: v1.0, first public version.
+*   2022-07-11: v1.1, added heap_min_key().
+*/
+
+#define ARITY 4
+// Marks an id that is not in the heap.
+#define NONE -1
+
+/*Defines an entry of the heap */
+typedef struct slot
+{
+        double key;
+        int id;
+} slot;
+/*Defines the heap */
+struct heap
+{
+        slot *slots;
+        int size;
+        int *pos;
+        int capacity;
+};
+/**
+* sift_up() - Move an entry towards the root until its parent is smaller.
+* @h: Heap to manipulate.
+* @i: Slot of the entry.
+*
+* The entry is held aside while larger parents move down, so each level
+* costs one copy instead of a swap.
+*
+* Returns: Nothing.
+*/
+static void sift_up(heap *h, int i)
+{
+        slot s = h->slots[i];
+        while (i > 0)
+        {
+                int parent = (i - 1) / ARITY;
+                if (h->slots[parent].key <= s.key)
+                {
+                        break;
+                }
+                h->slots[i] = h->slots[parent];
+                h->pos[h->slots[i].id] = i;
+                i = parent;
+        }
+        h->slots[i] = s;
+        h->pos[s.id] = i;
+}
+/**
+* sift_down() - Move an entry away from the root until its children are
+* larger.
+* @h: Heap to manipulate.
+* @i: Slot of the entry.
+*
+* Returns: Nothing.
+*/
+static void sift_down(heap *h, int i)
+{
+        slot s = h->slots[i];
+        while (true)
+        {
+                int first = ARITY * i + 1;
+                if (first >= h->size)
+                {
+                        break;
+                }
+                //Finds the smallest child
+                int last = first + ARITY < h->size ? first + ARITY : h->size;
+                int min = first;
+                for (int c = first + 1; c < last; c++)
+                {
+                        if (h->slots[c].key < h->slots[min].key)
+                        {
+                                min = c;
+                        }
+                }
+                if (s.key <= h->slots[min].key)
+                {
+                        break;
+                }
+                h->slots[i] = h->slots[min];
+                h->pos[h->slots[i].id] = i;
+                i = min;
+        }
+        h->slots[i] = s;
+        h->pos[s.id] = i;
+}
+/**
+* heap_empty() - Create an empty heap.
+* @capacity: Number of ids, i.e. ids are in the range [0, capacity).
+*
+* Returns: A pointer to the new heap.
+*/
+heap *heap_empty(int capacity)
+{
+        heap *h = calloc(1, sizeof(*h));
+        heap_fit(h, capacity);
+        return h;
+}
+/**
+* heap_fit() - Make room for more ids.
+* @h: Heap to manipulate.
+* @capacity: New number of ids. Smaller values are ignored.
+*
+* Returns: Nothing.
+*/
+void heap_fit(heap *h, int capacity)
+{
+        if (capacity <= h->capacity)
+        {
+                return;
+        }
+        h->slots = realloc(h->slots, capacity * sizeof(*h->slots));
+        h->pos = realloc(h->pos, capacity * sizeof(*h->pos));
+        for (int i = h->capacity; i < capacity; i++)
+        {
+                h->pos[i] = NONE;
+        }
+        h->capacity = capacity;
+}
+/**
+* heap_is_empty() - Check if a heap is empty.
+* @h: Heap to inspect.
+*
+* Returns: True if the heap holds no ids, otherwise false.
+*/
+bool heap_is_empty(const heap *h)
+{
+        return h->size == 0;
+}
+/**
+* heap_contains() - Check if an id is in a heap.
+* @h: Heap to inspect.
+* @id: Id to look for.
+*
+* Returns: True if id is in the heap, otherwise false.
+*/
+bool heap_contains(const heap *h, int id)
+{
+        return h->pos[id] != NONE;
+}
+/**
+* heap_insert() - Insert an id into a heap.
+* @h: Heap to manipulate.
+* @id: Id that is not in the heap.
+* @key: Key of the id.
+*
+* Returns: Nothing.
+*/
+void heap_insert(heap *h, int id, double key)
+{
+        int i = h->size++;
+        h->slots[i].key = key;
+        h->slots[i].id = id;
+        sift_up(h, i);
+}
+/**
+* heap_decrease_key() - Lower the key of an id in a heap.
+* @h: Heap to manipulate.
+* @id: Id in the heap.
+* @key: New key, not larger than the old one.
+*
+* Returns: Nothing.
+*/
+void heap_decrease_key(heap *h, int id, double key)
+{
+        int i = h->pos[id];
+        h->slots[i].key = key;
+        sift_up(h, i);
+}
+/**
+* heap_min_key() - Return the smallest key in a heap.
+* @h: Heap to inspect, not empty.
+*
+* Returns: The key of the id that heap_pop_min() would remove.
+*/
+double heap_min_key(const heap *h)
+{
+        return h->slots[0].key;
+}
+/**
+* heap_pop_min() - Remove the id with the smallest key from a heap.
+* @h: Heap to manipulate, not empty.
+*
+* Returns: The removed id.
+*/
+int heap_pop_min(heap *h)
+{
+        int id = h->slots[0].id;
+        h->pos[id] = NONE;
+        if (--h->size > 0)
+        {       //Moves the last entry to the root and lets it sink
+                h->slots[0] = h->slots[h->size];
+                sift_down(h, 0);
+        }
+        return id;
+}
+/**
+* heap_clear() - Remove all ids from a heap.
+* @h: Heap to manipulate.
+*
+* Returns: Nothing.
+*/
+void heap_clear(heap *h)
+{
+        for (int i = 0; i < h->size; i++)
+        {
+                h->pos[h->slots[i].id] = NONE;
+        }
+        h->size = 0;
+}
+/**
+* heap_kill() - Destroy a heap.
+* @h: Heap to destroy.
+*
+* Returns: Nothing.
+*/
+void heap_kill(heap *h)
+{
+        free(h->slots);
+        free(h->pos);
+        free(h);
+}
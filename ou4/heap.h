@@ -0,0 +1,124 @@
+#ifndef __HEAP_H
+#define __HEAP_H
+
+#include <stdbool.h>
+
+/*
+ * Declaration of an indexed min-heap over the ids 0, 1, 2, ... Each id is
+ * in the heap at most once, with a key of type double, and the heap knows
+ * the position of every id so that its key can be decreased in place. The
+ * heap is 4-ary: a node has four children, which makes the tree half as
+ * deep as a binary heap and keeps the children of a node in one cache
+ * line. After use, the function heap_kill() must be called to de-allocate
+ * the dynamic memory used by the heap.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-07-10: v1.0, first public version.
+ *   2022-07-11: v1.1, added heap_min_key().
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct heap heap;
+
+// =================== HEAP INTERFACE ======================
+
+/**
+ * heap_empty() - Create an empty heap.
+ * @capacity: Number of ids, i.e. ids are in the range [0, capacity).
+ *
+ * Returns: A pointer to the new heap.
+ */
+heap *heap_empty(int capacity);
+
+/**
+ * heap_fit() - Make room for more ids.
+ * @h: Heap to manipulate.
+ * @capacity: New number of ids. Smaller values are ignored.
+ *
+ * Returns: Nothing.
+ */
+void heap_fit(heap *h, int capacity);
+
+/**
+ * heap_is_empty() - Check if a heap is empty.
+ * @h: Heap to inspect.
+ *
+ * Returns: True if the heap holds no ids, otherwise false.
+ */
+bool heap_is_empty(const heap *h);
+
+/**
+ * heap_contains() - Check if an id is in a heap.
+ * @h: Heap to inspect.
+ * @id: Id to look for.
+ *
+ * Returns: True if id is in the heap, otherwise false.
+ */
+bool heap_contains(const heap *h, int id);
+
+/**
+ * heap_insert() - Insert an id into a heap.
+ * @h: Heap to manipulate.
+ * @id: Id that is not in the heap.
+ * @key: Key of the id.
+ *
+ * Takes O(log N) time.
+ *
+ * Returns: Nothing.
+ */
+void heap_insert(heap *h, int id, double key);
+
+/**
+ * heap_decrease_key() - Lower the key of an id in a heap.
+ * @h: Heap to manipulate.
+ * @id: Id in the heap.
+ * @key: New key, not larger than the old one.
+ *
+ * Takes O(log N) time.
+ *
+ * Returns: Nothing.
+ */
+void heap_decrease_key(heap *h, int id, double key);
+
+/**
+ * heap_min_key() - Return the smallest key in a heap.
+ * @h: Heap to inspect, not empty.
+ *
+ * Returns: The key of the id that heap_pop_min() would remove.
+ */
+double heap_min_key(const heap *h);
+
+/**
+ * heap_pop_min() - Remove the id with the smallest key from a heap.
+ * @h: Heap to manipulate, not empty.
+ *
+ * Takes O(log N) time.
+ *
+ * Returns: The removed id.
+ */
+int heap_pop_min(heap *h);
+
+/**
+ * heap_clear() - Remove all ids from a heap.
+ * @h: Heap to manipulate.
+ *
+ * Takes time in proportion to the number of ids in the heap, not to its
+ * capacity.
+ *
+ * Returns: Nothing.
+ */
+void heap_clear(heap *h);
+
+/**
+ * heap_kill() - Destroy a heap.
+ * @h: Heap to destroy.
+ *
+ * Returns: Nothing.
+ */
+void heap_kill(heap *h);
+
+#endif
@@ -1,13 +1,31 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
 #include <ctype.h>
 #include <errno.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 #include "dlist.h"
 #include "graph.h"
-#include "queue.h"
+#include "csr.h"
+#include "scc.h"
+#include "closure.h"
+#include "parallel_bfs.h"
+#include "bitset.h"
+#include "arena.h"
+#include "msbfs.h"
+#include "pll.h"
+#include "dynreach.h"
+#include "reach_cache.h"
+#include "heap.h"
+#include "ch.h"
+#include "geo.h"
 
 
 /*
@@ -24,12 +42,72 @@
 
 #define BUFSIZE 150
 #define bufsize 100
+//Size of the output buffer in batch mode
+#define OUTBUFSIZE (1 << 20)
+//Sides of a bidirectional search
+#define FORWARD 1
+#define BACKWARD 2
+//Number of origins whose reachable sets are cached with -l
+#define CACHE_ORIGINS 32
+//Printed between the nodes of a route
+#define ARROW " \u2192 "
+//Parameters of the FNV-1a hash of a map file
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+//Most fields kept from a line of the map file
+#define MAX_FIELDS 4
+//Room for a number in the map file, with its terminating '\0'
+#define NUMSIZE 64
+
+/*Defines the command line options */
+typedef struct options
+{
+        const char *map_file;
+        bool dense;
+        bool live;
+        bool undirected;
+        bool closure;
+        bool optimizing;
+        bool parallel;
+        int threads;
+        const char *batch_file;
+        bool labels;
+        bool routes;
+        bool cheapest;
+        bool hierarchy;
+        bool astar;
+} options;
+
+/*Defines the graph and the search structures used to answer queries */
+typedef struct query_data
+{
+        graph *g;
+        scc_graph *scc;
+        csr_search *search;
+        closure *reach;
+        csr_graph *frozen;
+        csr_graph *reverse;
+        parallel_bfs *pool;
+        pll_index *labels;
+        dynreach *dynamic;
+        reach_cache *cache;
+        ch_index *hierarchy;
+        geo *coords;
+} query_data;
 typedef struct graph
 {
         int *node_max;
         dlist *nodes;
 } graph;
 
+/*Defines a field of a line in the map file. It points into the mapped
+file, so it is not terminated and has a length instead */
+typedef struct field
+{
+        const char *start;
+        int length;
+} field;
+
 typedef struct node
 {
         const void *identifier;
@@ -37,473 +115,823 @@ typedef struct node
         bool seen_status;
 } node;
 /**
-* first_non_white_space() - Check where first non-whitespace is.
-* @s: Pointer to character.
+* add_edge() - Adds an edge between two named nodes to the graph.
+* @g: Pointer to graph.
+* @name1: Name of the origin node.
+* @name2: Name of the destination node.
+* @weight: Weight of the edge.
 *
-* Returns: i if s[i] is not NULL
-* Returns -1 if s[i] is NULL
+* Nodes that are not yet in the graph are inserted first. The names are
+* looked up by pointer and length, so they need not be terminated.
 *
+*Returns: The modified graph.
 */
-int first_non_white_space(const char *s)
+graph *add_edge(graph *g, const field *name1, const field *name2, double weight)
 {
-        int i = 0;
-        while (s[i] && isspace(s[i]))
+        //Finding nodes corresponding to name1 & name2 respectively
+        node *n1 = graph_find_node_n(g, name1->start, name1->length);
+        if (n1 == NULL)
         {
-                i++;
+                g = graph_insert_node_n(g, name1->start, name1->length);
+                n1 = graph_find_node_n(g, name1->start, name1->length);
         }
-        if (s[i])
+        node *n2 = graph_find_node_n(g, name2->start, name2->length);
+        if (n2 == NULL)
         {
-                return i;
+                g = graph_insert_node_n(g, name2->start, name2->length);
+                n2 = graph_find_node_n(g, name2->start, name2->length);
         }
-        else
+        // Insert an edge from n1 to n2
+        return graph_insert_weighted_edge(g, n1, n2, weight);
+}
+/*Defines one side of a bidirectional search. The nodes of the current
+level are nodes[head] up to (but not including) nodes[tail] */
+typedef struct frontier
+{
+        node **nodes;
+        int head;
+        int tail;
+} frontier;
+/**
+* expand_level() - Expands one level of one side of a bidirectional search.
+* @g: Pointer to graph.
+* @f: Frontier of the side to expand.
+* @side: Side that found each seen node, indexed by node id.
+* @this_side: FORWARD to follow out-edges, BACKWARD to follow in-edges.
+*
+* Returns: 1 if the two sides met, 0 if not.
+*/
+static bool expand_level(graph *g, frontier *f, unsigned char *side,
+                         unsigned char this_side)
+{
+        int end = f->tail;
+        for (; f->head < end; f->head++)
         {
-                return -1;
+                node *u = f->nodes[f->head];
+                graph_pos pos = this_side == FORWARD ?
+                        graph_neighbour_first(g, u) : graph_in_neighbour_first(g, u);
+                while (!graph_neighbour_is_end(g, pos))
+                {
+                        node *v = graph_neighbour_inspect(g, pos);
+                        int id = graph_node_id(g, v);
+                        if (!graph_node_is_seen(g, v))
+                        {       //v joins the next level of this side
+                                g = graph_node_set_seen(g, v, 1);
+                                side[id] = this_side;
+                                f->nodes[f->tail++] = v;
+                        }
+                        else if (side[id] != this_side)
+                        {       //v was reached from the other side
+                                return 1;
+                        }
+                        pos = this_side == FORWARD ?
+                                graph_neighbour_next(g, pos) : graph_in_neighbour_next(g, pos);
+                }
         }
+        return 0;
 }
 /**
-* last_non_white_space() - Check where last non-whitespace is.
-* @s: Pointer to character.
+* find_path() - Bidirectional breadth-first search.
+* @g: Pointer to graph.
+* @src: Pointer to source-node.
+* @dest: Pointer to destination-node
 *
-* Returns: i if i>= 0,
-* Returns -1 else
+* Searches forward from src along out-edges and backward from dest along
+* in-edges, always expanding the side with the smaller frontier, until
+* the sides meet or one side runs out of nodes. The seen status marks the
+* nodes found by either side and side[] tells which one, so side[] never
+* has to be cleared.
 *
+*Returns: 1 if there is a path
+*         0 if not.
 */
-int last_non_white_space(const char *s)
-{       //Defines i as length of string -1
-        int i = strlen(s) - 1;
-        while (i >= 0 && isspace(s[i]))
+bool find_path(graph *g, node *src, node *dest)
+{
+        if (src == dest)
         {
-                i--;
+                return 1;
         }
-        if (i >= 0)
+        int n = graph_node_count(g);
+        unsigned char *side = malloc(n);
+        frontier forward = { malloc(n * sizeof(node *)), 0, 0 };
+        frontier backward = { malloc(n * sizeof(node *)), 0, 0 };
+        //Each side starts with its own end node
+        g = graph_node_set_seen(g, src, 1);
+        side[graph_node_id(g, src)] = FORWARD;
+        forward.nodes[forward.tail++] = src;
+        g = graph_node_set_seen(g, dest, 1);
+        side[graph_node_id(g, dest)] = BACKWARD;
+        backward.nodes[backward.tail++] = dest;
+
+        bool found = 0;
+        while (!found && forward.head < forward.tail && backward.head < backward.tail)
         {
-                return i;
+                if (forward.tail - forward.head <= backward.tail - backward.head)
+                {
+                        found = expand_level(g, &forward, side, FORWARD);
+                }
+                else
+                {
+                        found = expand_level(g, &backward, side, BACKWARD);
+                }
         }
-        else
+        free(side);
+        free(forward.nodes);
+        free(backward.nodes);
+        //Resets seen status of nodes
+        g = graph_reset_seen(g);
+        return found;
+}
+/**
+* find_path_dense() - Breadth-first search with bitset frontiers.
+* @g: Pointer to graph.
+* @src: Pointer to source-node.
+* @dest: Pointer to destination-node
+*
+* Expands one whole level at a time with graph_union_neighbours(), which
+* ORs complete adjacency rows for the matrix graph in graph2.c.
+*
+* Returns: 1 if there is a path, 0 if not.
+*/
+bool find_path_dense(graph *g, node *src, node *dest)
+{
+        int n = graph_node_count(g);
+        int words = bitset_words(n);
+        int dest_id = graph_node_id(g, dest);
+        uint64_t *visited = bitset_empty(n);
+        uint64_t *frontier = bitset_empty(n);
+        uint64_t *next = bitset_empty(n);
+        bitset_set(visited, graph_node_id(g, src));
+        bitset_set(frontier, graph_node_id(g, src));
+        while (!bitset_test(visited, dest_id) && bitset_any(frontier, words))
         {
-                return -1;
+                //next = neighbours of frontier that are not visited
+                bitset_clear(next, words);
+                graph_union_neighbours(g, frontier, next);
+                bitset_andnot(next, visited, words);
+                bitset_or(visited, next, words);
+                uint64_t *tmp = frontier;
+                frontier = next;
+                next = tmp;
         }
+        bool found = bitset_test(visited, dest_id);
+        free(visited);
+        free(frontier);
+        free(next);
+        return found;
 }
 /**
-* number_of_strings() - Determine number of strings in char.
-* @s: Pointer to character.
+* search_all() - Finds every node that can be reached from a node.
+* @g: Pointer to graph.
+* @src: Pointer to source-node.
+* @reach: Cleared bitset over the node ids, filled in by the search.
+*
+* The bitset doubles as the visited marks of the breadth-first search.
 *
-* Returns: an integer, count.
+* Returns: Nothing.
 */
-int number_of_strings(const char *s)
+void search_all(const graph *g, node *src, uint64_t *reach)
 {
-        int beg = first_non_white_space(s);
-        int end = last_non_white_space(s);
-        int i = beg;
-        int count = 1;
-        int check = 0;
-        while (i <= end)
+        node **queue = malloc(graph_node_count(g) * sizeof(*queue));
+        int head = 0;
+        int tail = 0;
+        bitset_set(reach, graph_node_id(g, src));
+        queue[tail++] = src;
+        while (head < tail)
         {
-                if (isspace(s[i]) && !check)
+                node *v = queue[head++];
+                graph_pos p = graph_neighbour_first(g, v);
+                for (; !graph_neighbour_is_end(g, p); p = graph_neighbour_next(g, p))
                 {
-                        count++;
-                        check++;
-                        continue;
+                        node *w = graph_neighbour_inspect(g, p);
+                        int id = graph_node_id(g, w);
+                        if (!bitset_test(reach, id))
+                        {
+                                bitset_set(reach, id);
+                                queue[tail++] = w;
+                        }
                 }
-                check = 0;
-                i++;
         }
-        return count;
+        free(queue);
+}
+/**
+* find_path_cached() - Answers a query from the reachable set of the origin.
+* @cache: Reachable sets of recent origins.
+* @g: Pointer to graph.
+* @src: Pointer to source-node.
+* @dest: Pointer to destination-node.
+*
+* An origin that is not in the cache is searched with find_path(), which
+* stops when the sides meet. Only an origin that misses again gets a
+* search of everything it reaches, and its set is cached.
+*
+* Returns: 1 if there is a path, 0 if not.
+*/
+bool find_path_cached(reach_cache *cache, graph *g, node *src, node *dest)
+{
+        int origin = graph_node_id(g, src);
+        int found = reach_cache_test(cache, origin, graph_node_id(g, dest));
+        if (found < 0 && !reach_cache_admit(cache, origin))
+        {       //A one-off origin is not worth a search of the whole graph
+                found = find_path(g, src, dest);
+        }
+        else if (found < 0)
+        {
+                uint64_t *reach = reach_cache_insert(cache, origin, graph_node_count(g));
+                search_all(g, src, reach);
+                found = bitset_test(reach, graph_node_id(g, dest));
+        }
+        return found;
 }
+/*Defines the scratch space of route searches. parent[v] is the id of
+the node that labeled node v, or -1 if v is not labeled. Only the nodes in
+the queue are labeled, so they are the only ones cleared after a search.
+The cheapest-route search also keeps the cost of the best known route to
+each labeled node in dist, and the labeled nodes not yet settled in
+frontier. With -h the cheapest routes come from a contraction hierarchy
+instead, which has its own scratch space in ch, and with -a the search
+is guided by the coordinates in coords */
+typedef struct route_search
+{
+        int *parent;
+        int *route;
+        node **queue;
+        double *dist;
+        heap *frontier;
+        int size;
+        const ch_index *hierarchy;
+        ch_search *ch;
+        const geo *coords;
+} route_search;
 /**
-* remove_comment() - Removes text strings containing #.
-* @s: Pointer to character.
+* route_search_fit() - Makes room in a route search for all nodes of a graph.
+* @rs: Route search to grow.
+* @g: Pointer to graph.
 *
-* Returns: Modified string without comments.
+* Returns: Nothing.
 */
-char *remove_comment(char *s)
+void route_search_fit(route_search *rs, const graph *g)
 {
-        int stringlen = strlen(s);
-        char *substring = malloc(stringlen + 1);
-        int i = 0;
-        while (s[i] != '#' && i < stringlen)
+        int n = graph_node_count(g);
+        if (n <= rs->size)
+        {
+                return;
+        }
+        rs->parent = realloc(rs->parent, n * sizeof(*rs->parent));
+        rs->route = realloc(rs->route, n * sizeof(*rs->route));
+        rs->queue = realloc(rs->queue, n * sizeof(*rs->queue));
+        rs->dist = realloc(rs->dist, n * sizeof(*rs->dist));
+        if (rs->frontier == NULL)
+        {
+                rs->frontier = heap_empty(n);
+        }
+        heap_fit(rs->frontier, n);
+        for (int i = rs->size; i < n; i++)
         {
-                substring[i] = s[i];
-                i++;
+                rs->parent[i] = -1;
         }
-        substring[i] = '\0';
-        return substring;
+        rs->size = n;
 }
 /**
-* line_has_one_string() - Tests if given char is just one string.
-* @s: Pointer to character.
+* read_route() - Reads a route backwards along the parents of a search.
+* @rs: Route search whose parents lead from dest back to src.
+* @src_id: Id of the source node.
+* @dest_id: Id of the destination node.
 *
-* Returns: true if number_of_strings() returns 1
-* false otherwise.
+* The route is stored in rs->route, so rs->route[0] is src and
+* rs->route[hops] is dest.
+*
+* Returns: The number of hops, or -1 if dest is not labeled.
 */
-bool line_has_one_string(const char *s)
+int read_route(route_search *rs, int src_id, int dest_id)
 {
-        return number_of_strings(s) == 1;
+        if (rs->parent[dest_id] < 0)
+        {
+                return -1;
+        }
+        //Counts the hops, then fills in the route from the end
+        int hops = 0;
+        for (int v = dest_id; v != src_id; v = rs->parent[v])
+        {
+                hops++;
+        }
+        int v = dest_id;
+        for (int i = hops; i >= 0; i--)
+        {
+                rs->route[i] = v;
+                v = rs->parent[v];
+        }
+        return hops;
 }
 /**
-* line_is_blank - Tests if a given line of string is blank.
-* @s: Pointer to character.
+* find_route() - Finds a route with the fewest hops between two nodes.
+* @g: Pointer to graph.
+* @rs: Route search, fitted to the graph by the call.
+* @src: Pointer to source-node.
+* @dest: Pointer to destination-node.
 *
-* Returns: true if line is blank, otherwise false
+* A breadth-first search from src labels each node with its parent, and
+* stops as soon as dest is labeled. The route is then read backwards along
+* the parents into rs->route.
+*
+* Returns: The number of hops, or -1 if there is no path.
 */
-bool line_is_blank(const char *s)
+int find_route(const graph *g, route_search *rs, node *src, node *dest)
 {
-        return first_non_white_space(s) < 0;
+        route_search_fit(rs, g);
+        int src_id = graph_node_id(g, src);
+        int dest_id = graph_node_id(g, dest);
+        int head = 0;
+        int tail = 0;
+        rs->parent[src_id] = src_id;
+        rs->queue[tail++] = src;
+        while (head < tail && rs->parent[dest_id] < 0)
+        {
+                node *v = rs->queue[head++];
+                int v_id = graph_node_id(g, v);
+                graph_pos p = graph_neighbour_first(g, v);
+                for (; !graph_neighbour_is_end(g, p); p = graph_neighbour_next(g, p))
+                {
+                        node *w = graph_neighbour_inspect(g, p);
+                        int id = graph_node_id(g, w);
+                        if (rs->parent[id] < 0)
+                        {
+                                rs->parent[id] = v_id;
+                                rs->queue[tail++] = w;
+                                if (id == dest_id)
+                                {
+                                        break;
+                                }
+                        }
+                }
+        }
+        int hops = read_route(rs, src_id, dest_id);
+        for (int i = 0; i < tail; i++)
+        {
+                rs->parent[graph_node_id(g, rs->queue[i])] = -1;
+        }
+        return hops;
 }
 /**
-* line_is_comment - Tests if a given line of string is a comment.
-* @s: Pointer to character.
+* estimate() - Estimates the cost of the cheapest route from a node.
+* @guide: Coordinates of all nodes, or NULL.
+* @id: Id of the node.
+* @dest_id: Id of the destination.
 *
-* Returns: true if line is a comment and if i >= 0
-*          false otherwise.
+* Returns: A lower bound on the cost from id to dest_id, or 0 without
+* coordinates.
 */
-bool line_is_comment(const char *s)
+double estimate(const geo *guide, int id, int dest_id)
 {
-        int i = first_non_white_space(s);
-        return (i >= 0 && s[i] == '#');
+        return guide != NULL ? geo_bound(guide, id, dest_id) : 0;
 }
 /**
-* white_space() - Tests if a given line of string is "space"
-* @s: Pointer to character.
+* find_cheapest_route() - Finds a route with the lowest total weight
+* between two nodes.
+* @g: Pointer to graph.
+* @rs: Route search, fitted to the graph by the call.
+* @src: Pointer to source-node.
+* @dest: Pointer to destination-node.
+* @cost: Set to the total weight of the route, if there is one.
 *
-* Returns: integer i if s[i] = true, i.e not NULL
-*          false otherwise.
+* Dijkstra's algorithm: the labeled nodes wait in rs->frontier keyed by
+* the cost of the best route known so far, and the cheapest one is settled
+* next. A cheaper route to a waiting node lowers its key in place, so each
+* node is in the heap at most once. The search stops as soon as dest is
+* settled, so a query only touches the nodes cheaper to reach than dest.
+*
+* With rs->coords the search is A*: the key of a node is the cost of
+* reaching it plus a lower bound on the cost left to dest, so the search
+* heads for dest and settles fewer nodes. The bound obeys the triangle
+* inequality, so a settled node still never gets a cheaper route. It is
+* only used while every node has coordinates, since a node without them
+* could lie on a route cheaper than the bound.
+*
+* Returns: The number of hops of the route, or -1 if there is no path.
 */
-int white_space(const char *s)
+int find_cheapest_route(const graph *g, route_search *rs, node *src, node *dest,
+                        double *cost)
 {
-        int i = 0;
-        while (s[i] && !isspace(s[i]))
+        route_search_fit(rs, g);
+        int src_id = graph_node_id(g, src);
+        int dest_id = graph_node_id(g, dest);
+        const geo *guide = NULL;
+        if (rs->coords != NULL && geo_covers(rs->coords, graph_node_count(g)))
+        {
+                guide = rs->coords;
+        }
+        int tail = 0;
+        rs->parent[src_id] = src_id;
+        rs->dist[src_id] = 0;
+        rs->queue[tail++] = src;
+        heap_insert(rs->frontier, src_id, estimate(guide, src_id, dest_id));
+        while (!heap_is_empty(rs->frontier))
         {
-                i++;
+                int v_id = heap_pop_min(rs->frontier);
+                if (v_id == dest_id)
+                {
+                        break;
+                }
+                node *v = graph_node_by_id(g, v_id);
+                graph_pos p = graph_neighbour_first(g, v);
+                for (; !graph_neighbour_is_end(g, p); p = graph_neighbour_next(g, p))
+                {
+                        int id = graph_node_id(g, graph_neighbour_inspect(g, p));
+                        double d = rs->dist[v_id] + graph_neighbour_weight(g, p);
+                        if (rs->parent[id] < 0)
+                        {       //First route to the node
+                                rs->parent[id] = v_id;
+                                rs->dist[id] = d;
+                                rs->queue[tail++] = graph_node_by_id(g, id);
+                                heap_insert(rs->frontier, id, d + estimate(guide, id, dest_id));
+                        }
+                        else if (d < rs->dist[id] && heap_contains(rs->frontier, id))
+                        {       //Cheaper route to a node that is not settled
+                                rs->parent[id] = v_id;
+                                rs->dist[id] = d;
+                                heap_decrease_key(rs->frontier, id, d + estimate(guide, id, dest_id));
+                        }
+                }
         }
-        if (s[i])
+        int hops = read_route(rs, src_id, dest_id);
+        if (hops >= 0)
         {
-                return i;
+                *cost = rs->dist[dest_id];
         }
-        else
+        heap_clear(rs->frontier);
+        for (int i = 0; i < tail; i++)
         {
-                return -1;
+                rs->parent[graph_node_id(g, rs->queue[i])] = -1;
         }
+        return hops;
 }
 /**
-* count_white_spaces() - Counts number of blanks in given line of string.
-* @s: Pointer to character.
+* print_nodes() - Prints the nodes of a route.
+* @g: Pointer to graph.
+* @rs: Route search holding the route.
+* @hops: Number of hops of the route.
 *
-* Returns: integer white_space_cnt which is number of white spaces in line
+* Returns: Nothing.
 */
-int count_white_spaces(const char *s)
+void print_nodes(const graph *g, const route_search *rs, int hops)
 {
-        int i = 0;
-        int white_space_cnt = 0;
-        //While s[i] != NULL
-        while (s[i])
-        {       // if s[i] is a "space"
-        if (isspace(s[i]))
+        for (int i = 0; i <= hops; i++)
         {
-                white_space_cnt++;
+                printf("%s%s", i > 0 ? ARROW : "",
+                       graph_node_name(g, graph_node_by_id(g, rs->route[i])));
         }
-        i++;
 }
-// -1 to account for the last whitespace
-return white_space_cnt;
+/**
+* print_route() - Prints the route found by find_route().
+* @g: Pointer to graph.
+* @rs: Route search holding the route.
+* @hops: Number of hops of the route.
+*
+* Returns: Nothing.
+*/
+void print_route(const graph *g, const route_search *rs, int hops)
+{
+        printf("Route: ");
+        print_nodes(g, rs, hops);
+        printf(" (%d %s).\n", hops, hops == 1 ? "hop" : "hops");
 }
 /**
-* trim() - trims a given line of string.
-* @s: Pointer to character.
+* print_cheapest_route() - Finds and prints a route with the lowest total
+* weight between two nodes.
+* @g: Pointer to graph.
+* @rs: Route search.
+* @src: Pointer to source-node.
+* @dest: Pointer to destination-node, reachable from src.
 *
-* Returns: the trimmed line without comments and white spaces
+* The route comes from rs->hierarchy if there is one, otherwise from
+* find_cheapest_route(). If the hierarchy finds no route although the
+* graph has a path, it does not fit the graph, and find_cheapest_route()
+* is used as well.
 *
+* Returns: Nothing.
 */
-char *trim(char *line)
+void print_cheapest_route(const graph *g, route_search *rs, node *src, node *dest)
 {
-        //Remove lines of comment
-        char *stemp = remove_comment(line);
-        //Takes out the index of first non-whitespace
-        int first_non_blank = first_non_white_space(stemp);
-        //Takes out the index of last non-whitespace
-        int last_non_blank = last_non_white_space(stemp);
-        //Determines length of line without blanks
-        int length = last_non_blank - first_non_blank + 1;
-        //Allocates memory
-        char *s = malloc(strlen(stemp) + 1);
-        strncpy(s, &stemp[first_non_blank], length);
-        //Adds a "ending" to string
-        s[length] = '\0';
-        //Frees memotry of stemp
-        free(stemp);
-        return s;
+        double cost = 0;
+        int hops;
+        if (rs->hierarchy != NULL)
+        {
+                route_search_fit(rs, g);
+                if (rs->ch == NULL)
+                {
+                        rs->ch = ch_search_empty(rs->hierarchy);
+                }
+                hops = ch_route(rs->hierarchy, rs->ch, graph_node_id(g, src), graph_node_id(g, dest),
+                                &cost, (uint32_t *)rs->route);
+        }
+        if (rs->hierarchy == NULL || hops < 0)
+        {
+                hops = find_cheapest_route(g, rs, src, dest, &cost);
+        }
+        printf("Cheapest route: ");
+        print_nodes(g, rs, hops);
+        printf(" (cost %g).\n", cost);
 }
 /**
-* build_graph() - Builds the graph
-* @str: Pointer to character.
-* @max_elements integer
+* route_search_kill() - Frees the scratch space of a route search.
+* @rs: Route search to free.
 *
-*Returns: The graph with corresponding nodes & strings
+* Returns: Nothing.
 */
-graph *build_graph(char **str1, char **str2, int max_elements, int edges)
+void route_search_kill(route_search *rs)
 {
-        //Creates empty graph
-        graph *g = graph_empty(max_elements);
-        for (int i = 0; i < edges; i++)
+        free(rs->parent);
+        free(rs->route);
+        free(rs->queue);
+        free(rs->dist);
+        if (rs->frontier != NULL)
+        {
+                heap_kill(rs->frontier);
+        }
+        if (rs->ch != NULL)
+        {
+                ch_search_kill(rs->ch);
+        }
+}
+/**
+* set_str_to_empty() - Takes a string and sets first position to '\0'.
+* @str: String that is to be emptied.
+*
+* Returns: Nothing.
+*/
+void set_nodes_to_empty(char *empty_node1, char *empty_node2)
+{
+        empty_node1[0] = '\0';
+        empty_node2[0] = '\0';
+}
+/**
+* split_line() - Splits a line of the map file into fields.
+* @line: First character of the line.
+* @end: The character after the line.
+* @fields: Room for MAX_FIELDS fields.
+*
+* The fields are separated by any amount of white space, and a # starts a
+* comment that runs to the end of the line. Nothing is copied, the fields
+* point into the line.
+*
+* Returns: The number of fields. Only the first MAX_FIELDS are stored.
+*/
+int split_line(const char *line, const char *end, field *fields)
+{
+        int count = 0;
+        const char *p = line;
+        while (p < end && *p != '#')
         {
-                //Finding nodes corresponding to str1 & str2 respectively
-                if (graph_find_node(g, str1[i]) == NULL)
+                if (isspace((unsigned char)*p))
                 {
-                        g = graph_insert_node(g, str1[i]);
+                        p++;
+                        continue;
                 }
-                if (graph_find_node(g, str2[i]) == NULL)
+                const char *start = p;
+                while (p < end && *p != '#' && !isspace((unsigned char)*p))
                 {
-                        g = graph_insert_node(g, str2[i]);
+                        p++;
                 }
-                // Get the nodes just inserted
-
-                node *n1 = graph_find_node(g, str1[i]);
-                node *n2 = graph_find_node(g, str2[i]);
-                // Insert an edge from n1 to n2
-                if (n1 != NULL && n2 != NULL)
+                if (count < MAX_FIELDS)
                 {
-                        g = graph_insert_edge(g, n1, n2);
+                        fields[count].start = start;
+                        fields[count].length = p - start;
                 }
+                count++;
         }
-
-        return g;
+        return count;
 }
 /**
-* find_path() - function that utilizes breadthfirst
-* @g: Pointer to graph.
-* @src: Pointer to source-node.
-* @dest: Pointer to destination-node
+* field_is(): Checks if a field holds a given word.
+* @f: Field to check.
+* @word: Word to compare with.
 *
-*Returns: 1 if nodes are equal
-*         0 if not.
+* Returns: true if the field is the word, otherwise false.
 */
-bool find_path(graph *g, node *src, node *dest)
+bool field_is(const field *f, const char *word)
 {
-        //Creates an empty queue
-        queue *q = queue_empty(NULL);
-        //Changes seen status for source node
-        g = graph_node_set_seen(g, src, 1);
-        //queues the source node on the queue
-        q = queue_enqueue(q, src);
-        while (!queue_is_empty(q))
-        {       //Inspects the node on the queues front
-                node *inspectedNode = queue_front(q);
-                if (nodes_are_equal(inspectedNode, dest))
-                {       //Resets seen status of all nodes
-                        g = graph_reset_seen(g);
-                        //kills the queue and frees allocated memory
-                        queue_kill(q);
-                        return 1;
-                }
-                //Dequeues node first in queue.
-                q = queue_dequeue(q);
-                //Creates a list of neighbours to inspectedNode
-                dlist *neighbours = graph_neighbours(g, inspectedNode);
-                //Takes out first position of list of neighbours.
-                dlist_pos pos = dlist_first(neighbours);
-                while (!dlist_is_end(neighbours, pos))
-                {
-                        node *neighbour = dlist_inspect(neighbours, pos);
-                        //If given node is NOT seen
-                        if (!graph_node_is_seen(g, neighbour))
-                        {       //Change seen status to 1(i.e seen)
-                                g = graph_node_set_seen(g, neighbour, 1);
-                                //queue the node.
-                                q = queue_enqueue(q, neighbour);
-                        }
-                        pos = dlist_next(neighbours, pos);
-                }
-                //Kills and free allocated memory of list
-                dlist_kill(neighbours);
+        return (int)strlen(word) == f->length && !strncmp(f->start, word, f->length);
+}
+/**
+* field_to_number() - Converts a field of the map file to a number.
+* @f: Field to convert.
+* @number: Set to the number.
+*
+* The field is copied to a buffer on the stack first, since strtod()
+* needs a terminated string.
+*
+* Returns: true if the whole field is a finite number, otherwise false.
+*/
+bool field_to_number(const field *f, double *number)
+{
+        char copy[NUMSIZE];
+        if (f->length >= NUMSIZE)
+        {
+                return false;
         }
-        //Kills and free allocated memory of queue
-        queue_kill(q);
-        //Resets seen status of nodes
-        g = graph_reset_seen(g);
-        return 0;
+        memcpy(copy, f->start, f->length);
+        copy[f->length] = '\0';
+        char *end;
+        errno = 0;
+        *number = strtod(copy, &end);
+        return end == &copy[f->length] && end != copy && errno == 0 && isfinite(*number);
 }
 /**
-* count_nodes() - Counts the number of unique nodes in 2 given strings.
-* @str1: string of start nodes.
-* @str2: string of destination nodes.
-* @edges: number of edges.
-*
-* Returns: Number of unique nodes.
-*/
-int count_nodes(char **str1, char **str2, int edges)
-{
-        // Allocate memory for unique nodes
-        char **uniquenodes = malloc(BUFSIZE);
-        // Initiate number of unique nodes to 0
-        int cnt = 0;
-        // This is a status that it used to determine whether a given node already exists
-        // in uniquenodes.
-        int status1, status2;
-        for(int i = 0; i < edges; i++) {
-                // Initiate status to true
-                status1 = 1;
-                status2 = 1;
-                // Read node i from tempstr1 and tempstr2
-                char *tempstr1 = (char*)str1[i];
-                char *tempstr2 = (char*)str2[i];
-                for(int j = 0; j < cnt; j++) {
-                        // If node tempstr1 already is in uniquenodes
-                        if(!strcmp(uniquenodes[j],tempstr1) && status1) {
-                                status1 = 0;
-                        }
-                        // If node tempstr2 already is in uniquenodes
-                        if(!strcmp(uniquenodes[j],tempstr2)  && status2) {
-                                status2 = 0;
-                        }
-                }
-                if(status1) {
-                        // Insert tempstr1 to uniquenodes if it doesn't already exist
-                        // and increase cnt by 1.
-                        uniquenodes[cnt] = malloc(BUFSIZE);
-                        strcpy(uniquenodes[cnt], tempstr1);
-                        cnt++;
-                }
-                if(status2) {
-                        // Insert tempstr2 to uniquenodes if it doesn't already exist
-                        // and increase cnt by 1.
-                        uniquenodes[cnt] = malloc(BUFSIZE);
-                        strcpy(uniquenodes[cnt], tempstr2);
-                        cnt++;
-                }
+* field_to_weight() - Converts a field to the weight of an edge.
+* @f: The weight field.
+* @weight: Set to the weight.
+*
+* The cheapest-route search assumes that no edge has a negative weight,
+* so only finite, non-negative numbers are weights.
+*
+* Returns: true if f is a valid weight, otherwise false.
+*/
+bool field_to_weight(const field *f, double *weight)
+{
+        return field_to_number(f, weight) && *weight >= 0;
+}
+/**
+* parse_weight() - Parses the weight column of a line in the map file.
+* @f: The weight field.
+*
+* Exits with an error if f is not a valid weight.
+*
+* Returns: The weight.
+*/
+double parse_weight(const field *f)
+{
+        double weight;
+        if (!field_to_weight(f, &weight))
+        {
+                fprintf(stderr, "ERROR: Invalid edge weight %.*s!\n", f->length, f->start);
+                exit(EXIT_FAILURE);
         }
-        // Deallocate memory for uniquenodes.
-        for(int i = 0; i < cnt; i++) {
-                free(uniquenodes[i]);
+        return weight;
+}
+/**
+* parse_coordinate() - Parses a latitude or longitude in the map file.
+* @f: The field with the coordinate in degrees.
+* @limit: Largest absolute value allowed, 90 or 180.
+*
+* Exits with an error if f is not a number in the range [-limit, limit].
+*
+* Returns: The coordinate.
+*/
+double parse_coordinate(const field *f, double limit)
+{
+        double degrees;
+        if (!field_to_number(f, &degrees) || degrees < -limit || degrees > limit)
+        {
+                fprintf(stderr, "ERROR: Invalid coordinate %.*s!\n", f->length, f->start);
+                exit(EXIT_FAILURE);
         }
-        free(uniquenodes);
-        // Return cnt.
-        return cnt;
+        return degrees;
 }
 /**
-* set_str_to_empty() - Takes a string and sets first position to '\0'.
-* @str: String that is to be emptied.
+* add_coordinates() - Gives a named node its coordinates.
+* @g: Pointer to graph.
+* @coords: Coordinates of the nodes of g.
+* @fields: The four fields of a "NODE NAME LAT LON" line.
 *
-* Returns: Nothing.
+* The node is inserted first if it is not yet in the graph.
+*
+* Returns: The modified graph.
 */
-void set_nodes_to_empty(char *empty_node1, char *empty_node2)
+graph *add_coordinates(graph *g, geo *coords, const field *fields)
 {
-        empty_node1[0] = '\0';
-        empty_node2[0] = '\0';
+        const field *name = &fields[1];
+        double latitude = parse_coordinate(&fields[2], 90);
+        double longitude = parse_coordinate(&fields[3], 180);
+        if (graph_find_node_n(g, name->start, name->length) == NULL)
+        {
+                g = graph_insert_node_n(g, name->start, name->length);
+        }
+        node *n = graph_find_node_n(g, name->start, name->length);
+        geo_set(coords, graph_node_id(g, n), latitude, longitude);
+        return g;
 }
 /**
 * read_map() - Reads and parses information from the map file
-* containing a description of a graph.
-* @argv: Command line arguments.
-* @iter: Iteration counter.
-* @str1: Array of origin node names.
-* @str2: Array of destination node names.
+* containing a description of a graph, and builds the graph.
+* @map_file: Name of the map file, or NULL if none was given.
+* @coords: Set to the coordinates given in the map.
 *
-* Returns: Number of edges in the graph.
+* The graph is built in the same pass as the file is read, and it grows
+* as new nodes are found, so the number of nodes need not be known. An
+* edge line is "ORIGIN DEST" or "ORIGIN DEST WEIGHT", where a missing
+* weight counts as 1. A line "NODE NAME LAT LON" gives the latitude and
+* longitude of a node in degrees, e.g. "NODE UME 63.79 20.28".
+*
+* The file is mapped into memory and split into fields that point into
+* the mapping, so nothing is allocated per line and lines may be of any
+* length. Only the names of new nodes are copied, by the graph.
+*
+* Returns: The graph described by the map.
 */
-int read_map(const char **argv, int *iter, char **str1, char **str2)
+graph *read_map(const char *map_file, geo *coords)
 {
-        char line[BUFSIZE];
-        char **information = malloc(BUFSIZE);
-        FILE *in;
-        int edges, length1, length2;
-        int check = 0;
-        //Reads in the map-file to in
-        if (argv[1] != NULL)
+        if (map_file == NULL)
         {
-                in = fopen(argv[1], "r");
-        }
-        else {
                 fprintf(stderr,"ERROR: No input!\n");
                 exit(EXIT_FAILURE);
         }
-        if(in == NULL) {
+        struct stat info;
+        int fd = open(map_file, O_RDONLY);
+        if (fd < 0 || fstat(fd, &info) != 0)
+        {
                 fprintf(stderr,"ERROR: Empty file!\n");
                 exit(EXIT_FAILURE);
         }
-
-        while (fgets(line, BUFSIZE, in) != NULL)
-        {       //If line from map-file is blank or comment
-                if (line_is_blank(line) || line_is_comment(line))
+        size_t size = info.st_size;
+        const char *map = NULL;
+        if (size > 0)
+        {
+                map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (map == MAP_FAILED)
+                {
+                        fprintf(stderr, "ERROR: Can not map %s!\n", map_file);
+                        exit(EXIT_FAILURE);
+                }
+                //The file is read once from start to end
+                posix_madvise((void *)map, size, POSIX_MADV_SEQUENTIAL);
+        }
+        //The mapping stays valid after the file is closed
+        close(fd);
+        //Creates empty graph
+        graph *g = graph_empty(0);
+        field fields[MAX_FIELDS];
+        bool first = true;
+        int edges = 0;
+        for (size_t pos = 0; pos < size;)
+        {       //Finds the end of the line, the last one may lack a newline
+                const char *line = &map[pos];
+                const char *end = memchr(line, '\n', size - pos);
+                if (end == NULL)
+                {
+                        end = &map[size];
+                }
+                pos = end - map + 1;
+                int count = split_line(line, end, fields);
+                //If line from map-file is blank or comment
+                if (count == 0)
                 {
                         continue;
                 }
                 // Check if first non-commented line is an integer
-                if (check == 0)
+                if (first)
                 {
-                        check = 1;
-                        if (!line_has_one_string(line))
-                        {       //Prints error to stderr
+                        first = false;
+                        if (count != 1)
+                        {
                                 fprintf(stderr, "ERROR: The first line contains more than one string!\n");
                                 exit(EXIT_FAILURE);
                         }
-                        else if (!isdigit(*line))
-                        {       //Prints error to stderr
+                        else if (!isdigit((unsigned char)fields[0].start[0]))
+                        {
                                 fprintf(stderr, "ERROR: The first line is not a number!\n");
                                 exit(EXIT_FAILURE);
                         }
                 }
-
-                if (line_has_one_string(line))
-                {       //reads number in string
-                        edges = atoi(line);
-                        if(!isdigit(*(char*)line)) {
+                if (count == 1)
+                {       //The number of edges is not needed to build the graph
+                        if (!isdigit((unsigned char)fields[0].start[0]))
+                        {
                                 fprintf(stderr, "ERROR: Bad format!\n");
                                 exit(EXIT_FAILURE);
                         }
                         continue;
                 }
-
-                information[*iter] = trim(line);
-                // Check that number of whitespaces are correct
-                if (count_white_spaces(information[*iter]) != 1)
+                if (field_is(&fields[0], "NODE"))
+                {       //A NODE line never counts as an edge, even if malformed
+                        if (count != 4)
+                        {
+                                fprintf(stderr, "ERROR: A NODE line must be NODE NAME LAT LON!\n");
+                                exit(EXIT_FAILURE);
+                        }
+                        g = add_coordinates(g, coords, fields);
+                        continue;
+                }
+                // Check that number of fields is correct
+                if (count != 2 && count != 3)
                 {
                         fprintf(stderr, "ERROR: Not the correct number of whitespaces!\n");
                         exit(EXIT_FAILURE);
                 }
-
-                //Allocates two string elements
-                str1[*iter] = malloc(BUFSIZE);
-                str2[*iter] = malloc(BUFSIZE);
-                length1 = white_space(information[*iter]);
-                length2 = strlen(information[*iter]) - length1 - 1;
-                //Adds a terminator to string
-                str1[*iter][length1] = '\0';
-                str2[*iter][length2] = '\0';
-                // Read strings from the file
-                memcpy(str1[*iter], &information[*iter][0], length1);
-                memcpy(str2[*iter], &information[*iter][length1 + 1], length2);
-                free(information[*iter]);
-                *iter = *iter + 1;
-        }
-        if(!(*iter)) {
-                fprintf(stderr,"Error: Empty file!\n");
-                exit(EXIT_FAILURE);
+                //An optional third column holds the weight of the edge
+                double weight = count == 3 ? parse_weight(&fields[2]) : 1;
+                //The graph copies the names, so the mapping can be dropped after
+                g = add_edge(g, &fields[0], &fields[1], weight);
+                edges++;
         }
-        //Frees allocated memory used by information
-        free(information);
-        //closes the read-in file
-        fclose(in);
-        return edges;
-}
-/**
-* free_strings() - Frees all memory in the strings given.
-* @str1: Array of origin node names.
-* @str2: Array of destination node names.
-* @iter: Number of elements in str1 and str2.
-*
-* Returns: Nothing.
-*/
-void free_strings(char **str1, char **str2, int *iter)
-{
-        //Free memory of each allocated element in str1 and str2 respectively
-        for (int i = *iter - 1; i >= 0; i--)
+        if (map != NULL)
         {
-                free(str1[i]);
-                free(str2[i]);
+                munmap((void *)map, size);
+        }
+        if(!edges) {
+                fprintf(stderr,"Error: Empty file!\n");
+                exit(EXIT_FAILURE);
         }
-        //Frees str1 & str2
-        free(str1);
-        free(str2);
+        return g;
 }
 /**
 * nodes_do_not_exist() - Checks if any of the given nodes are null.
@@ -527,37 +955,812 @@ char *nodes_do_not_exist(node *origin, node *destination, char *node1, char *nod
                 return NULL;
 }
 
-int main(int argc, const char **argv)
+/**
+* parse_args() - Reads the command line options.
+* @argc: Number of command line arguments.
+* @argv: Command line arguments.
+*
+* Usage: is_connected [-d] [-l] [-u] [-c] [-o] [-p] [-i] [-r] [-w] [-h] [-a]
+*                     [-t threads] [-b query-file] map-file
+*   -d  Search with bitset frontiers instead of the condensation of the graph.
+*   -l  Search the live graph with a bidirectional search instead of the
+*       condensation of the graph. The reachable sets of the last
+*       CACHE_ORIGINS repeated origins are cached, and the hit rate is
+*       printed at exit.
+*   -u  The map is undirected, so queries are answered from the
+*       connected components without searching.
+*   -c  Build the transitive closure of the condensation when the map is
+*       loaded, so every query is a bit test.
+*   -o  Search a frozen copy of the graph with a direction-optimizing
+*       (top-down/bottom-up) search.
+*   -p  Search a frozen copy of the graph with a multithreaded search.
+*   -i  Answer queries from a 2-hop label index. The index is saved in
+*       map-file.pll and reused as long as the map is unchanged.
+*   -r  Print a route with the fewest hops for every path found.
+*   -w  Print a route with the lowest total weight for every path found.
+*   -h  Like -w, but the routes come from a contraction hierarchy. The
+*       hierarchy is saved in map-file.ch and reused as long as it is
+*       newer than the map.
+*   -a  Like -w, but the search is A*, guided towards the destination by
+*       the NODE coordinates of the map. Without coordinates for every
+*       node it is the same as -w.
+*   -t  Number of threads used by -c, -p and -i. The default is one per
+*       processor.
+*   -b  Answer the "ORIGIN DEST" pairs in query-file, or on stdin if
+*       query-file is -, instead of prompting for queries.
+*
+* At the prompt, "add ORIGIN DEST [WEIGHT]" and "cancel ORIGIN DEST" add and
+* cancel routes. An added route without a weight has the weight 1. Without
+* -c, -o, -p, -i and -h the later queries see the change.
+*
+* Returns: The options.
+*/
+options parse_args(int argc, const char **argv)
 {
-        char line[BUFSIZE];
-        int edges;
-        // int *iter;
-        int it = 0;
-        int *iter = &it;
-        char **str1 = malloc(BUFSIZE);
-        char **str2 = malloc(BUFSIZE);
-
-        // Read map file, return nr of edges
-        edges = read_map(argv, iter, str1, str2);
-
-        //Build graph from map information
-        graph *g = build_graph(str1, str2, count_nodes(str1, str2, edges), edges);
-
-        // Initialize node names as empty
-        char node1[BUFSIZE];
-        char node2[BUFSIZE];
-        set_nodes_to_empty(node1, node2);
-        do
+        options opts = { NULL, false, false, false, false, false, false, 0, NULL, false, false, false, false, false };
+        for (int i = 1; i < argc; i++)
         {
-                printf("Enter origin and destination (quit to exit): ");
-                //Reads in entered origin and destination into line
-                fgets(line, sizeof(line), stdin);
-                sscanf(line, "%s %s", node1, node2);
+                if (!strcmp(argv[i], "-d"))
+                {
+                        opts.dense = true;
+                }
+                else if (!strcmp(argv[i], "-l"))
+                {
+                        opts.live = true;
+                }
+                else if (!strcmp(argv[i], "-u"))
+                {
+                        opts.undirected = true;
+                }
+                else if (!strcmp(argv[i], "-c"))
+                {
+                        opts.closure = true;
+                }
+                else if (!strcmp(argv[i], "-o"))
+                {
+                        opts.optimizing = true;
+                }
+                else if (!strcmp(argv[i], "-p"))
+                {
+                        opts.parallel = true;
+                }
+                else if (!strcmp(argv[i], "-i"))
+                {
+                        opts.labels = true;
+                }
+                else if (!strcmp(argv[i], "-r"))
+                {
+                        opts.routes = true;
+                }
+                else if (!strcmp(argv[i], "-w"))
+                {
+                        opts.cheapest = true;
+                }
+                else if (!strcmp(argv[i], "-h"))
+                {
+                        opts.cheapest = true;
+                        opts.hierarchy = true;
+                }
+                else if (!strcmp(argv[i], "-a"))
+                {
+                        opts.cheapest = true;
+                        opts.astar = true;
+                }
+                else if (!strcmp(argv[i], "-t") && i + 1 < argc)
+                {
+                        opts.threads = atoi(argv[++i]);
+                        if (opts.threads <= 0)
+                        {
+                                fprintf(stderr, "ERROR: Invalid number of threads %s!\n", argv[i]);
+                                exit(EXIT_FAILURE);
+                        }
+                }
+                else if (!strcmp(argv[i], "-b") && i + 1 < argc)
+                {
+                        opts.batch_file = argv[++i];
+                }
+                else if (argv[i][0] == '-')
+                {
+                        fprintf(stderr, "ERROR: Unknown option %s!\n", argv[i]);
+                        exit(EXIT_FAILURE);
+                }
+                else
+                {
+                        opts.map_file = argv[i];
+                }
+        }
+        return opts;
+}
+/**
+* path_exists() - Answers a query with the search chosen by the options.
+* @opts: Command line options.
+* @qd: Graph and search structures.
+* @src: Pointer to source-node.
+* @dest: Pointer to destination-node
+*
+* Returns: 1 if there is a path, 0 if not.
+*/
+bool path_exists(const options *opts, query_data *qd, node *src, node *dest)
+{
+        if (opts->undirected)
+        {
+                //In an undirected graph a path exists within a component
+                return graph_same_component(qd->g, src, dest);
+        }
+        if (opts->dense)
+        {
+                return find_path_dense(qd->g, src, dest);
+        }
+        if (qd->labels != NULL)
+        {
+                return pll_path_exists(qd->labels, graph_node_id(qd->g, src),
+                                       graph_node_id(qd->g, dest));
+        }
+        if (qd->pool != NULL)
+        {
+                return parallel_bfs_path_exists(qd->pool, graph_node_id(qd->g, src),
+                                                graph_node_id(qd->g, dest));
+        }
+        if (qd->frozen != NULL)
+        {
+                return csr_path_exists_hybrid(qd->frozen, qd->reverse, qd->search,
+                                              graph_node_id(qd->g, src),
+                                              graph_node_id(qd->g, dest));
+        }
+        if (qd->reach != NULL)
+        {
+                return closure_path_exists(qd->reach, graph_node_id(qd->g, src),
+                                           graph_node_id(qd->g, dest));
+        }
+        if (qd->dynamic != NULL)
+        {     //Nodes in one component reach each other, others search the DAG
+                return dynreach_path_exists(qd->dynamic, src, dest);
+        }
+        if (qd->cache != NULL)
+        {
+                return find_path_cached(qd->cache, qd->g, src, dest);
+        }
+        return find_path(qd->g, src, dest);
+}
+/**
+* map_fingerprint() - Hashes the contents of a map file.
+* @map_file: Name of the map file.
+*
+* A saved index is only reused for a map with the same fingerprint. The
+* times of the files are not enough, since copying can give a changed map
+* an older time than its index. The hash is 64-bit FNV-1a.
+*
+* Returns: The fingerprint, or 0 if the file can not be read.
+*/
+uint64_t map_fingerprint(const char *map_file)
+{
+        uint64_t hash = FNV_OFFSET;
+        struct stat info;
+        int fd = open(map_file, O_RDONLY);
+        if (fd < 0)
+        {
+                return 0;
+        }
+        const unsigned char *map = NULL;
+        size_t size = fstat(fd, &info) == 0 ? info.st_size : 0;
+        if (size > 0)
+        {
+                map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (map == MAP_FAILED)
+        {
+                return 0;
+        }
+        for (size_t i = 0; i < size; i++)
+        {
+                hash = (hash ^ map[i]) * FNV_PRIME;
+        }
+        if (map != NULL)
+        {
+                munmap((void *)map, size);
+        }
+        return hash;
+}
+/**
+* index_file_name() - Names the file an index of a map is saved in.
+* @map_file: Name of the map file.
+* @suffix: Suffix of the index file, e.g. ".pll".
+*
+* Returns: The name, to be freed by the caller.
+*/
+char *index_file_name(const char *map_file, const char *suffix)
+{
+        char *index_file = malloc(strlen(map_file) + strlen(suffix) + 1);
+        strcpy(index_file, map_file);
+        strcat(index_file, suffix);
+        return index_file;
+}
+/**
+* load_labels() - Loads the 2-hop index of a map, or builds and saves it.
+* @opts: Command line options.
+* @g: Pointer to the graph read from opts->map_file.
+*
+* Returns: The index.
+*/
+pll_index *load_labels(const options *opts, const graph *g)
+{
+        pll_index *labels = NULL;
+        char *index_file = index_file_name(opts->map_file, ".pll");
+        uint64_t fingerprint = map_fingerprint(opts->map_file);
+        labels = pll_load(index_file, graph_node_count(g), fingerprint);
+        if (labels == NULL)
+        {       //The index is missing or out of date
+                scc_graph *scc = graph_condense(g);
+                labels = scc_labels(scc, opts->threads);
+                scc_kill(scc);
+                if (!pll_save(labels, index_file, fingerprint))
+                {
+                        fprintf(stderr, "WARNING: Could not save the index to %s!\n", index_file);
+                }
+        }
+        free(index_file);
+        return labels;
+}
+/**
+* load_hierarchy() - Loads the contraction hierarchy of a map, or builds
+* and saves it.
+* @opts: Command line options.
+* @g: Pointer to the graph read from opts->map_file.
+*
+* Returns: The hierarchy.
+*/
+ch_index *load_hierarchy(const options *opts, const graph *g)
+{
+        ch_index *hierarchy = NULL;
+        char *index_file = index_file_name(opts->map_file, ".ch");
+        uint64_t fingerprint = map_fingerprint(opts->map_file);
+        hierarchy = ch_load(index_file, graph_node_count(g), fingerprint);
+        if (hierarchy == NULL)
+        {       //The hierarchy is missing or out of date
+                hierarchy = graph_contract(g);
+                if (!ch_save(hierarchy, index_file, fingerprint))
+                {
+                        fprintf(stderr, "WARNING: Could not save the hierarchy to %s!\n", index_file);
+                }
+        }
+        free(index_file);
+        return hierarchy;
+}
+/**
+* guide_search() - Prepares the coordinates read with the map for -a.
+* @opts: Command line options.
+* @g: Pointer to the graph read from opts->map_file.
+* @coords: Coordinates read from opts->map_file.
+*
+* Returns: The coordinates fitted to the edges of g, or NULL if they are
+* not used. They are freed in the latter case.
+*/
+geo *guide_search(const options *opts, const graph *g, geo *coords)
+{
+        if (!opts->astar || opts->hierarchy)
+        {
+                geo_kill(coords);
+                return NULL;
+        }
+        geo_fit_edges(coords, g);
+        if (!geo_covers(coords, graph_node_count(g)))
+        {
+                fprintf(stderr, "WARNING: Not all nodes have coordinates, so -a searches like -w!\n");
+        }
+        return coords;
+}
+/**
+* query_data_create() - Sets up the search structures for a graph.
+* @opts: Command line options.
+* @g: Pointer to graph.
+* @coords: Coordinates that guide cheapest-route searches, or NULL.
+*
+* Returns: The query data.
+*/
+query_data query_data_create(const options *opts, graph *g, geo *coords)
+{
+        query_data qd = { g, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, coords };
+        if (opts->hierarchy)
+        {
+                qd.hierarchy = load_hierarchy(opts, g);
+        }
+        if (opts->live && !opts->undirected && !opts->dense)
+        {     //Repeated origins are answered from their reachable sets
+                qd.cache = reach_cache_empty(CACHE_ORIGINS);
+        }
+        if (opts->undirected || opts->dense || opts->live)
+        {
+                return qd;
+        }
+        if (opts->labels)
+        {
+                qd.labels = load_labels(opts, g);
+        }
+        else if (opts->parallel)
+        {     //The threads share the frozen copy and keep their own marks
+                qd.frozen = graph_freeze(g);
+                qd.pool = parallel_bfs_empty(qd.frozen, opts->threads);
+        }
+        else if (opts->optimizing)
+        {     //Bottom-up levels need the in-edges as well
+                qd.frozen = graph_freeze(g);
+                qd.reverse = csr_transpose(qd.frozen);
+                qd.search = csr_search_empty(qd.frozen);
+        }
+        else if (opts->closure)
+        {     //Pays once at load time for constant time queries
+                qd.scc = graph_condense(g);
+                qd.reach = scc_closure(qd.scc, opts->threads);
+        }
+        else
+        {     //The condensation follows the routes added and cancelled later
+                qd.dynamic = dynreach_empty(g);
+        }
+        return qd;
+}
+/**
+* query_data_kill() - Frees the search structures and the graph.
+* @qd: Query data to free.
+*
+* Returns: Nothing.
+*/
+void query_data_kill(query_data *qd)
+{
+        if (qd->reach != NULL)
+        {
+                closure_kill(qd->reach);
+        }
+        if (qd->scc != NULL)
+        {
+                scc_kill(qd->scc);
+        }
+        if (qd->pool != NULL)
+        {
+                parallel_bfs_kill(qd->pool);
+        }
+        if (qd->labels != NULL)
+        {
+                pll_kill(qd->labels);
+        }
+        if (qd->frozen != NULL)
+        {
+                csr_kill(qd->frozen);
+        }
+        if (qd->reverse != NULL)
+        {
+                csr_kill(qd->reverse);
+        }
+        if (qd->search != NULL)
+        {
+                csr_search_kill(qd->search);
+        }
+        if (qd->dynamic != NULL)
+        {
+                dynreach_kill(qd->dynamic);
+        }
+        if (qd->hierarchy != NULL)
+        {
+                ch_kill(qd->hierarchy);
+        }
+        if (qd->cache != NULL)
+        {
+                reach_cache_kill(qd->cache);
+        }
+        if (qd->coords != NULL)
+        {
+                geo_kill(qd->coords);
+        }
+        graph_kill(qd->g);
+}
+/**
+* has_route() - Checks if there is an edge between two nodes.
+* @g: Pointer to graph.
+* @src: Pointer to source-node.
+* @dest: Pointer to destination-node.
+*
+* Returns: true if the edge exists, otherwise false.
+*/
+bool has_route(const graph *g, const node *src, const node *dest)
+{
+        graph_pos p = graph_neighbour_first(g, src);
+        for (; !graph_neighbour_is_end(g, p); p = graph_neighbour_next(g, p))
+        {
+                if (graph_neighbour_inspect(g, p) == dest)
+                {
+                        return true;
+                }
+        }
+        return false;
+}
+/**
+* route_inserted() - Fits the coordinates of -a to an added route.
+* @qd: Graph and search structures.
+* @name1: Name of the origin node.
+* @name2: Name of the destination node.
+* @weight: Weight of the route.
+*
+* Returns: Nothing.
+*/
+void route_inserted(query_data *qd, const char *name1, const char *name2, double weight)
+{
+        if (qd->coords != NULL)
+        {
+                geo_edge_inserted(qd->coords, graph_node_id(qd->g, graph_find_node(qd->g, name1)),
+                                  graph_node_id(qd->g, graph_find_node(qd->g, name2)), weight);
+        }
+}
+/**
+* change_route() - Adds or cancels a route between two named nodes.
+* @qd: Graph and search structures.
+* @add: true to add the route, false to cancel it.
+* @name1: Name of the origin node.
+* @name2: Name of the destination node.
+* @weight: Weight of an added route, ignored when it is cancelled.
+*
+* Nodes that are not yet in the graph are inserted when a route is added.
+* The searches over a frozen copy of the map (-c, -o, -p, -i and -h) would
+* not see the change, so it is refused when one of them is used. With -a
+* an added route may lower the cost per kilometre of the bound.
+*
+* Returns: Nothing.
+*/
+void change_route(query_data *qd, bool add, const char *name1, const char *name2,
+                  double weight)
+{
+        if (qd->reach != NULL || qd->frozen != NULL || qd->labels != NULL
+            || qd->hierarchy != NULL)
+        {
+                printf("Routes can not be changed with -c, -o, -p, -i or -h.\n\n");
+                return;
+        }
+        if (add)
+        {
+                if (qd->dynamic == NULL)
+                {
+                        field origin = { name1, strlen(name1) };
+                        field dest = { name2, strlen(name2) };
+                        qd->g = add_edge(qd->g, &origin, &dest, weight);
+                        if (qd->cache != NULL)
+                        {
+                                reach_cache_edge_inserted(qd->cache,
+                                        graph_node_id(qd->g, graph_find_node(qd->g, name1)),
+                                        graph_node_id(qd->g, graph_find_node(qd->g, name2)));
+                        }
+                        route_inserted(qd, name1, name2, weight);
+                        printf("Added a route from %s to %s.\n\n", name1, name2);
+                        return;
+                }
+                if (graph_find_node(qd->g, name1) == NULL)
+                {
+                        qd->g = dynreach_insert_node(qd->dynamic, name1);
+                }
+                if (graph_find_node(qd->g, name2) == NULL)
+                {
+                        qd->g = dynreach_insert_node(qd->dynamic, name2);
+                }
+                qd->g = dynreach_insert_weighted_edge(qd->dynamic, graph_find_node(qd->g, name1),
+                                                      graph_find_node(qd->g, name2), weight);
+                route_inserted(qd, name1, name2, weight);
+                printf("Added a route from %s to %s.\n\n", name1, name2);
+                return;
+        }
+        node *src = graph_find_node(qd->g, name1);
+        node *dest = graph_find_node(qd->g, name2);
+        if (src == NULL || dest == NULL || !has_route(qd->g, src, dest))
+        {
+                printf("There is no route from %s to %s.\n\n", name1, name2);
+                return;
+        }
+        if (qd->cache != NULL)
+        {
+                reach_cache_edge_deleted(qd->cache, graph_node_id(qd->g, src));
+        }
+        qd->g = qd->dynamic != NULL ? dynreach_delete_edge(qd->dynamic, src, dest)
+                                    : graph_delete_edge(qd->g, src, dest);
+        printf("Cancelled the route from %s to %s.\n\n", name1, name2);
+}
+/**
+* print_cache_stats() - Prints how many queries the cache answered.
+* @cache: Cache to report on.
+*
+* Returns: Nothing.
+*/
+void print_cache_stats(const reach_cache *cache)
+{
+        reach_cache_stats stats = reach_cache_get_stats(cache);
+        long queries = stats.hits + stats.misses;
+        printf("Reachable-set cache: %ld of %ld queries answered from the cache (%.1f%% hit rate), %ld sets dropped by route changes.\n",
+               stats.hits, queries, queries > 0 ? 100.0 * stats.hits / queries : 0.0,
+               stats.dropped);
+}
+
+/*Defines a query of a batch. The names are kept for the output, and a
+node id is -1 if the name is not in the graph */
+typedef struct batch_query
+{
+        const char *origin_name;
+        const char *dest_name;
+        int origin;
+        int dest;
+        bool found;
+} batch_query;
+/*Defines a batch of queries in the order they were read. The names are
+allocated from an arena */
+typedef struct batch
+{
+        batch_query *queries;
+        int n;
+        int size;
+        arena *names;
+} batch;
+/**
+* read_batch() - Reads the queries of a batch.
+* @batch_file: Name of the query file, or - for stdin.
+* @g: Pointer to graph, to look up the node ids.
+*
+* Returns: The batch.
+*/
+batch read_batch(const char *batch_file, const graph *g)
+{
+        char *line = NULL;
+        size_t line_size = 0;
+        field fields[MAX_FIELDS];
+        FILE *in = strcmp(batch_file, "-") ? fopen(batch_file, "r") : stdin;
+        if (in == NULL)
+        {
+                fprintf(stderr, "ERROR: Can not open %s!\n", batch_file);
+                exit(EXIT_FAILURE);
+        }
+        batch b = { malloc(1024 * sizeof(batch_query)), 0, 1024, arena_empty(0) };
+        ssize_t length;
+        //getline() grows the line, so a long line is never split in two
+        while ((length = getline(&line, &line_size, in)) != -1)
+        {
+                int count = split_line(line, &line[length], fields);
+                //If the line is blank or a comment
+                if (count == 0)
+                {
+                        continue;
+                }
+                if (count != 2)
+                {
+                        fprintf(stderr, "ERROR: Query %d does not have two names!\n", b.n + 1);
+                        exit(EXIT_FAILURE);
+                }
+                if (b.n == b.size)
+                {
+                        b.size *= 2;
+                        b.queries = realloc(b.queries, b.size * sizeof(batch_query));
+                }
+                batch_query *q = &b.queries[b.n++];
+                q->origin_name = arena_strndup(b.names, fields[0].start, fields[0].length);
+                q->dest_name = arena_strndup(b.names, fields[1].start, fields[1].length);
+                node *origin = graph_find_node_n(g, fields[0].start, fields[0].length);
+                node *dest = graph_find_node_n(g, fields[1].start, fields[1].length);
+                q->origin = origin != NULL ? graph_node_id(g, origin) : -1;
+                q->dest = dest != NULL ? graph_node_id(g, dest) : -1;
+                q->found = false;
+        }
+        free(line);
+        if (in != stdin)
+        {
+                fclose(in);
+        }
+        return b;
+}
+/**
+* answer_batch() - Answers the queries of a batch.
+* @b: Batch to answer.
+* @g: Pointer to graph.
+*
+* The queries are sorted by origin with a counting sort. The distinct
+* origins are searched MSBFS_SOURCES at a time by one multi-source search
+* of a frozen copy of the graph, and all queries from those origins are
+* answered from its masks.
+*
+* Returns: Nothing.
+*/
+void answer_batch(batch *b, const graph *g)
+{
+        int n = graph_node_count(g);
+        csr_graph *frozen = graph_freeze(g);
+        uint64_t *reach = malloc((n + 1) * sizeof(uint64_t));
+        uint32_t sources[MSBFS_SOURCES];
+        int ends[MSBFS_SOURCES];
+        //Counting sort of the query indices by origin
+        int *start = calloc(n + 1, sizeof(int));
+        int *order = malloc((b->n + 1) * sizeof(int));
+        for (int i = 0; i < b->n; i++)
+        {
+                if (b->queries[i].origin >= 0)
+                {
+                        start[b->queries[i].origin + 1]++;
+                }
+        }
+        for (int v = 0; v < n; v++)
+        {
+                start[v + 1] += start[v];
+        }
+        for (int i = 0; i < b->n; i++)
+        {
+                if (b->queries[i].origin >= 0)
+                {
+                        order[start[b->queries[i].origin]++] = i;
+                }
+        }
+        //start[v] is now the end of the queries from v
+        int k = 0;
+        int v = 0;
+        while (v < n)
+        {       //Collects the next group of origins with queries
+                int count = 0;
+                for (; v < n && count < MSBFS_SOURCES; v++)
+                {
+                        if (start[v] > (v > 0 ? start[v - 1] : 0))
+                        {
+                                sources[count] = v;
+                                ends[count++] = start[v];
+                        }
+                }
+                if (count == 0)
+                {
+                        break;
+                }
+                csr_reach_many(frozen, sources, count, reach);
+                //The queries of origin i are the next ones in order
+                for (int i = 0; i < count; i++)
+                {
+                        for (; k < ends[i]; k++)
+                        {
+                                batch_query *q = &b->queries[order[k]];
+                                q->found = q->dest >= 0 && ((reach[q->dest] >> i) & 1);
+                        }
+                }
+        }
+        free(start);
+        free(order);
+        free(reach);
+        csr_kill(frozen);
+}
+/**
+* write_batch() - Writes the answers of a batch to stdout.
+* @b: Batch to write.
+* @g: Pointer to graph.
+* @opts: Command line options, -r and -w write routes after every path
+* found.
+* @hierarchy: Contraction hierarchy of the graph, or NULL.
+* @coords: Coordinates that guide cheapest-route searches, or NULL.
+*
+* The answers are written in the order of the queries, through a large
+* output buffer.
+*
+* Returns: Nothing.
+*/
+void write_batch(const batch *b, const graph *g, const options *opts,
+                 const ch_index *hierarchy, const geo *coords)
+{
+        route_search rs = { NULL, NULL, NULL, NULL, NULL, 0, hierarchy, NULL, coords };
+        setvbuf(stdout, NULL, _IOFBF, OUTBUFSIZE);
+        for (int i = 0; i < b->n; i++)
+        {
+                const batch_query *q = &b->queries[i];
+                if (q->origin < 0 || q->dest < 0)
+                {
+                        printf("Node %s does not exist.\n", q->origin < 0 ? q->origin_name : q->dest_name);
+                }
+                else if (q->found)
+                {
+                        printf("There is a path from %s to %s.\n", q->origin_name, q->dest_name);
+                        node *origin = graph_node_by_id(g, q->origin);
+                        node *dest = graph_node_by_id(g, q->dest);
+                        if (opts->routes)
+                        {
+                                print_route(g, &rs, find_route(g, &rs, origin, dest));
+                        }
+                        if (opts->cheapest)
+                        {
+                                print_cheapest_route(g, &rs, origin, dest);
+                        }
+                }
+                else
+                {
+                        printf("There is no path from %s to %s.\n", q->origin_name, q->dest_name);
+                }
+        }
+        fflush(stdout);
+        route_search_kill(&rs);
+}
+/**
+* batch_kill() - Frees the queries of a batch.
+* @b: Batch to free.
+*
+* Returns: Nothing.
+*/
+void batch_kill(batch *b)
+{
+        free(b->queries);
+        arena_kill(b->names);
+}
+
+int main(int argc, const char **argv)
+{
+        char line[BUFSIZE];
+
+        options opts = parse_args(argc, argv);
+        //Build graph from map information
+        geo *coords = geo_empty();
+        graph *g = read_map(opts.map_file, coords);
+        coords = guide_search(&opts, g, coords);
+        if (opts.batch_file != NULL)
+        {       //Answers all queries at once, without prompting
+                batch b = read_batch(opts.batch_file, g);
+                answer_batch(&b, g);
+                ch_index *hierarchy = opts.hierarchy ? load_hierarchy(&opts, g) : NULL;
+                write_batch(&b, g, &opts, hierarchy, coords);
+                if (hierarchy != NULL)
+                {
+                        ch_kill(hierarchy);
+                }
+                if (coords != NULL)
+                {
+                        geo_kill(coords);
+                }
+                batch_kill(&b);
+                graph_kill(g);
+                return 0;
+        }
+        query_data qd = query_data_create(&opts, g, coords);
+
+        // Initialize node names as empty
+        char node1[BUFSIZE];
+        char node2[BUFSIZE];
+        char node3[BUFSIZE];
+        route_search rs = { NULL, NULL, NULL, NULL, NULL, 0, qd.hierarchy, NULL, qd.coords };
+        set_nodes_to_empty(node1, node2);
+        do
+        {
+                printf("Enter origin and destination (quit to exit): ");
+                //Reads in entered origin and destination into line
+                if (fgets(line, sizeof(line), stdin) == NULL)
+                {       //The end of the input works as quit
+                        printf("\n");
+                        break;
+                }
+                node3[0] = '\0';
+                sscanf(line, "%s %s %s", node1, node2, node3);
                 //If user enters quit, will skip steps below and exit loop
                 if (!strcmp(node1, "quit"))
                 {
                         continue;
                 }
+                else if (!strcmp(node1, "add") || !strcmp(node1, "cancel"))
+                {       //"add ORIGIN DEST [WEIGHT]" and "cancel ORIGIN DEST" change the map
+                        bool add = node1[0] == 'a';
+                        field fields[MAX_FIELDS];
+                        int count = split_line(line, &line[strlen(line)], fields);
+                        double weight = 1;
+                        if (count < 3)
+                        {
+                                printf("Please enter both an origin and a destination\n\n");
+                        }
+                        else if (count > (add ? 4 : 3))
+                        {       //Nothing may follow the route, so no word is dropped
+                                printf("Too many words, enter %s ORIGIN DEST%s!\n\n",
+                                       node1, add ? " [WEIGHT]" : "");
+                        }
+                        else if (count == 4 && !field_to_weight(&fields[3], &weight))
+                        {
+                                printf("Invalid edge weight %.*s, try again!\n\n",
+                                       fields[3].length, fields[3].start);
+                        }
+                        else
+                        {
+                                change_route(&qd, add, node2, node3, weight);
+                        }
+                        set_nodes_to_empty(node1, node2);
+                        continue;
+                }
                 // If any of the nodes are left empty, prompt the user to reenter
                 // origin and destination
                 else if (node1[0] == '\0' || node2[0] == '\0'){
@@ -566,17 +1769,26 @@ int main(int argc, const char **argv)
                 }
                 else
                 {       //Creates nodes corresponding to origin and destination
-                        node *origin = graph_find_node(g, node1);
-                        node *destination = graph_find_node(g, node2);
+                        node *origin = graph_find_node(qd.g, node1);
+                        node *destination = graph_find_node(qd.g, node2);
                         char *non_existent_node = nodes_do_not_exist(origin, destination, node1, node2);
                         if (non_existent_node){
                                 printf("Node %s does not exist, try again!\n\n", non_existent_node);
                                 set_nodes_to_empty(node1, node2);
                                 continue;
                         }
-                        if (find_path(g, origin, destination))
+                        if (path_exists(&opts, &qd, origin, destination))
                         {       //If there is a path between origin and destination
-                                printf("There is a path from %s to %s.\n\n", node1, node2);
+                                printf("There is a path from %s to %s.\n", node1, node2);
+                                if (opts.routes)
+                                {
+                                        print_route(qd.g, &rs, find_route(qd.g, &rs, origin, destination));
+                                }
+                                if (opts.cheapest)
+                                {
+                                        print_cheapest_route(qd.g, &rs, origin, destination);
+                                }
+                                printf("\n");
                         }
                         else
                         {       //If there is not a path between origin and destination
@@ -587,9 +1799,12 @@ int main(int argc, const char **argv)
 
         } while (strcmp(node1, "quit"));
 
+        if (qd.cache != NULL)
+        {
+                print_cache_stats(qd.cache);
+        }
+        route_search_kill(&rs);
         //Kills and free memory of graph
-        graph_kill(g);
-        // Free all memory for str1 and str2
-        free_strings(str1, str2, iter);
+        query_data_kill(&qd);
         printf("Normal exit.\n");
 }
@@ -0,0 +1,90 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "csr.h"
+#include "msbfs.h"
+
+/*
+* Implementation of a multi-source breadth-first search. visit[v] holds the
+* sources that reached v at the current level, and the nodes with a
+* non-zero visit mask are kept in a list so that a level only touches
+* the nodes in it.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-07-05: v1.0, first public version.
+*/
+
+/**
+* csr_reach_many() - Find the nodes that can be reached from some sources.
+* @c: Frozen graph to search.
+* @sources: Ids of the sources.
+* @count: Number of sources, 1 to MSBFS_SOURCES.
+* @reach: Array of c->n words to fill in.
+*
+* Returns: Nothing.
+*/
+void csr_reach_many(const csr_graph *c, const uint32_t *sources, int count,
+                    uint64_t *reach)
+{
+        uint64_t *visit = calloc(c->n + 1, sizeof(*visit));
+        uint64_t *visit_next = calloc(c->n + 1, sizeof(*visit_next));
+        uint32_t *level = malloc((c->n + 1) * sizeof(*level));
+        uint32_t *level_next = malloc((c->n + 1) * sizeof(*level_next));
+        uint32_t size = 0;
+
+        memset(reach, 0, c->n * sizeof(*reach));
+        for (int i = 0; i < count; i++)
+        {
+                uint32_t s = sources[i];
+                if (!visit[s])
+                {
+                        level[size++] = s;
+                }
+                reach[s] |= (uint64_t)1 << i;
+                visit[s] |= (uint64_t)1 << i;
+        }
+        while (size > 0)
+        {
+                uint32_t size_next = 0;
+                for (uint32_t k = 0; k < size; k++)
+                {
+                        uint32_t v = level[k];
+                        uint64_t sources_at_v = visit[v];
+                        for (uint32_t e = c->offsets[v]; e < c->offsets[v + 1]; e++)
+                        {
+                                uint32_t w = c->targets[e];
+                                //The sources that reach w for the first time
+                                uint64_t found = sources_at_v & ~reach[w];
+                                if (found)
+                                {
+                                        if (!visit_next[w])
+                                        {
+                                                level_next[size_next++] = w;
+                                        }
+                                        visit_next[w] |= found;
+                                        reach[w] |= found;
+                                }
+                        }
+                }
+                //Clears the masks of this level, then moves to the next one
+                for (uint32_t k = 0; k < size; k++)
+                {
+                        visit[level[k]] = 0;
+                }
+                uint64_t *tmp_visit = visit;
+                visit = visit_next;
+                visit_next = tmp_visit;
+                uint32_t *tmp_level = level;
+                level = level_next;
+                level_next = tmp_level;
+                size = size_next;
+        }
+        free(visit);
+        free(visit_next);
+        free(level);
+        free(level_next);
+}
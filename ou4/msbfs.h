@@ -0,0 +1,41 @@
+#ifndef __MSBFS_H
+#define __MSBFS_H
+
+#include <stdint.h>
+#include "csr.h"
+
+/*
+ * Declaration of a multi-source breadth-first search (MS-BFS) over a
+ * frozen graph (see csr.h) that searches from up to 64 sources at once.
+ * Every node has a 64-bit mask with one bit per source, so the sources
+ * share one pass over the edges instead of making one pass each.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-07-05: v1.0, first public version.
+ */
+
+// Largest number of sources of one search.
+#define MSBFS_SOURCES 64
+
+// =================== MS-BFS INTERFACE ======================
+
+/**
+ * csr_reach_many() - Find the nodes that can be reached from some sources.
+ * @c: Frozen graph to search.
+ * @sources: Ids of the sources.
+ * @count: Number of sources, 1 to MSBFS_SOURCES.
+ * @reach: Array of c->n words to fill in.
+ *
+ * On return, bit i of reach[v] is set if node v can be reached from node
+ * sources[i]. A node is expanded once per level for all the sources that
+ * reached it at that level, with one AND-NOT and one OR per edge.
+ *
+ * Returns: Nothing.
+ */
+void csr_reach_many(const csr_graph *c, const uint32_t *sources, int count,
+                    uint64_t *reach);
+
+#endif
@@ -0,0 +1,233 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "name_index.h"
+
+/*
+* Implementation of a hash index from node names to values. Uses open
+* addressing with linear probing, and the table is doubled whenever it
+* becomes half full. Removal shifts later entries of the probe chain back,
+* so no tombstones are needed.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-06-20: v1.0, first public version.
+*   2022-07-14: v1.1, names can be looked up by pointer and length.
+*/
+
+#define MIN_CAPACITY 16
+
+/*Defines a slot in the table. An empty slot has key NULL */
+typedef struct slot
+{
+        const char *key;
+        unsigned int hash;
+        void *value;
+} slot;
+/*Defines the index structure */
+struct name_index
+{
+        slot *slots;
+        unsigned int mask;
+        int size;
+};
+/**
+* hash_string() - FNV-1a hash of a string.
+* @s: First character of the string.
+* @length: Number of characters in the string.
+*
+* Returns: The hash value.
+*/
+static unsigned int hash_string(const char *s, int length)
+{
+        unsigned int h = 2166136261u;
+        for (int i = 0; i < length; i++)
+        {
+                h ^= (unsigned char)s[i];
+                h *= 16777619u;
+        }
+        return h;
+}
+/**
+* find_slot() - Find the slot holding a name, or the empty slot ending its
+* probe chain.
+* @t: Index to inspect.
+* @s: First character of the name to look for.
+* @length: Number of characters in the name.
+* @h: Hash of the name.
+*
+* Returns: Index of the slot.
+*/
+static unsigned int find_slot(const name_index *t, const char *s, int length,
+                              unsigned int h)
+{
+        unsigned int i = h & t->mask;
+        while (t->slots[i].key != NULL)
+        {       //strncmp stops at the end of a shorter key
+                const char *key = t->slots[i].key;
+                if (t->slots[i].hash == h && !strncmp(key, s, length) && key[length] == '\0')
+                {
+                        return i;
+                }
+                i = (i + 1) & t->mask;
+        }
+        return i;
+}
+/**
+* grow() - Double the number of slots and rehash all entries.
+* @t: Index to manipulate.
+*
+* Returns: Nothing.
+*/
+static void grow(name_index *t)
+{
+        slot *old = t->slots;
+        unsigned int old_capacity = t->mask + 1;
+        t->mask = 2 * old_capacity - 1;
+        t->slots = calloc(t->mask + 1, sizeof(*t->slots));
+        for (unsigned int i = 0; i < old_capacity; i++)
+        {
+                if (old[i].key != NULL)
+                {
+                        unsigned int j = old[i].hash & t->mask;
+                        while (t->slots[j].key != NULL)
+                        {
+                                j = (j + 1) & t->mask;
+                        }
+                        t->slots[j] = old[i];
+                }
+        }
+        free(old);
+}
+/**
+* name_index_empty() - Create an empty name index.
+* @capacity: Expected number of names, or 0 if unknown.
+*
+* Returns: A pointer to the new index.
+*/
+name_index *name_index_empty(int capacity)
+{
+        name_index *t = calloc(1, sizeof(*t));
+        unsigned int slots = MIN_CAPACITY;
+        //Keep the table at most half full for the expected size
+        while (capacity > 0 && slots < 2 * (unsigned int)capacity)
+        {
+                slots *= 2;
+        }
+        t->slots = calloc(slots, sizeof(*t->slots));
+        t->mask = slots - 1;
+        return t;
+}
+/**
+* name_index_lookup() - Look up the value stored for a name.
+* @t: Index to inspect.
+* @s: Name to look up.
+*
+* Returns: The value stored for the name, or NULL if not present.
+*/
+void *name_index_lookup(const name_index *t, const char *s)
+{
+        return name_index_lookup_n(t, s, strlen(s));
+}
+/**
+* name_index_lookup_n() - Look up the value stored for a name that is a
+* piece of a longer string.
+* @t: Index to inspect.
+* @s: First character of the name, which need not be terminated.
+* @length: Number of characters in the name.
+*
+* Returns: The value stored for the name, or NULL if not present.
+*/
+void *name_index_lookup_n(const name_index *t, const char *s, int length)
+{
+        unsigned int i = find_slot(t, s, length, hash_string(s, length));
+        return t->slots[i].value;
+}
+/**
+* name_index_insert() - Store a value for a name.
+* @t: Index to manipulate.
+* @s: Name to use as key. The pointer itself is stored.
+* @v: Value to store.
+*
+* Returns: The modified index.
+*/
+name_index *name_index_insert(name_index *t, const char *s, void *v)
+{
+        int length = strlen(s);
+        unsigned int h = hash_string(s, length);
+        unsigned int i = find_slot(t, s, length, h);
+        if (t->slots[i].key == NULL)
+        {
+                if (2 * (unsigned int)(t->size + 1) > t->mask + 1)
+                {
+                        grow(t);
+                        i = find_slot(t, s, length, h);
+                }
+                t->slots[i].key = s;
+                t->slots[i].hash = h;
+                t->size++;
+        }
+        t->slots[i].value = v;
+        return t;
+}
+/**
+* name_index_remove() - Remove a name from the index.
+* @t: Index to manipulate.
+* @s: Name to remove.
+*
+* Returns: The modified index.
+*/
+name_index *name_index_remove(name_index *t, const char *s)
+{
+        int length = strlen(s);
+        unsigned int i = find_slot(t, s, length, hash_string(s, length));
+        if (t->slots[i].key == NULL)
+        {
+                return t;
+        }
+        //Shift later entries of the probe chain back into the hole
+        unsigned int j = i;
+        while (true)
+        {
+                t->slots[i].key = NULL;
+                t->slots[i].value = NULL;
+                unsigned int home;
+                do
+                {
+                        j = (j + 1) & t->mask;
+                        if (t->slots[j].key == NULL)
+                        {
+                                t->size--;
+                                return t;
+                        }
+                        home = t->slots[j].hash & t->mask;
+                        //Entry at j may only move if its home is not in (i, j]
+                } while (i <= j ? (i < home && home <= j) : (i < home || home <= j));
+                t->slots[i] = t->slots[j];
+                i = j;
+        }
+}
+/**
+* name_index_size() - Return the number of names in the index.
+* @t: Index to inspect.
+*
+* Returns: The number of stored names.
+*/
+int name_index_size(const name_index *t)
+{
+        return t->size;
+}
+/**
+* name_index_kill() - Destroy a given name index.
+* @t: Index to destroy.
+*
+* Returns: Nothing.
+*/
+void name_index_kill(name_index *t)
+{
+        free(t->slots);
+        free(t);
+}
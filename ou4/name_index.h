@@ -0,0 +1,95 @@
+#ifndef __NAME_INDEX_H
+#define __NAME_INDEX_H
+
+#include <stdbool.h>
+
+/*
+ * Declaration of a hash index that maps node names to values, used by
+ * the graph implementations to look up nodes in O(1) average time.
+ * The index stores the key pointers as given, so the names must stay
+ * valid for as long as they are stored in the index. After use, the
+ * function name_index_kill() must be called to de-allocate the dynamic
+ * memory used by the index itself.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-06-20: v1.0, first public version.
+ *   2022-07-14: v1.1, added name_index_lookup_n().
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct name_index name_index;
+
+// =================== NAME INDEX INTERFACE ======================
+
+/**
+ * name_index_empty() - Create an empty name index.
+ * @capacity: Expected number of names, or 0 if unknown.
+ *
+ * Returns: A pointer to the new index.
+ */
+name_index *name_index_empty(int capacity);
+
+/**
+ * name_index_lookup() - Look up the value stored for a name.
+ * @t: Index to inspect.
+ * @s: Name to look up.
+ *
+ * Returns: The value stored for the name, or NULL if not present.
+ */
+void *name_index_lookup(const name_index *t, const char *s);
+
+/**
+ * name_index_lookup_n() - Look up the value stored for a name that is
+ * a piece of a longer string.
+ * @t: Index to inspect.
+ * @s: First character of the name, which need not be terminated.
+ * @length: Number of characters in the name.
+ *
+ * Returns: The value stored for the name, or NULL if not present.
+ */
+void *name_index_lookup_n(const name_index *t, const char *s, int length);
+
+/**
+ * name_index_insert() - Store a value for a name.
+ * @t: Index to manipulate.
+ * @s: Name to use as key. The pointer itself is stored.
+ * @v: Value to store.
+ *
+ * If the name is already present its value is replaced.
+ *
+ * Returns: The modified index.
+ */
+name_index *name_index_insert(name_index *t, const char *s, void *v);
+
+/**
+ * name_index_remove() - Remove a name from the index.
+ * @t: Index to manipulate.
+ * @s: Name to remove.
+ *
+ * Returns: The modified index. Removing a missing name is a no-op.
+ */
+name_index *name_index_remove(name_index *t, const char *s);
+
+/**
+ * name_index_size() - Return the number of names in the index.
+ * @t: Index to inspect.
+ *
+ * Returns: The number of stored names.
+ */
+int name_index_size(const name_index *t);
+
+/**
+ * name_index_kill() - Destroy a given name index.
+ * @t: Index to destroy.
+ *
+ * Neither the names nor the values are de-allocated.
+ *
+ * Returns: Nothing.
+ */
+void name_index_kill(name_index *t);
+
+#endif
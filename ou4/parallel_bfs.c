@@ -0,0 +1,295 @@
+#define _POSIX_C_SOURCE 200112L
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "csr.h"
+#include "parallel_bfs.h"
+
+/*
+* Implementation of a level-synchronous breadth-first search with a pool
+* of pthreads. The calling thread works as thread 0, and all threads meet
+* at a barrier to start a query, after expanding a level and after
+* building the next level.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-07-03: v1.0, first public version.
+*/
+
+// Number of frontier nodes a thread takes at a time.
+#define CHUNK 64
+
+/*Defines the nodes one thread claims during a level */
+typedef struct buffer
+{
+        uint32_t *nodes;
+        uint32_t count;
+        uint32_t size;
+} buffer;
+/*Defines the search. Level l is levels[l%2][0..level_size) and its nodes
+are handed out through cursors[l%2] */
+struct parallel_bfs
+{
+        const csr_graph *c;
+        int threads;
+        pthread_t *ids;
+        pthread_barrier_t barrier;
+        //Node v is visited in the current query if seen[v] == epoch
+        uint32_t *seen;
+        uint32_t epoch;
+        uint32_t *levels[2];
+        uint32_t level_size;
+        uint32_t cursors[2];
+        buffer *buffers;
+        //The current query, set by thread 0 before the start barrier
+        uint32_t dest;
+        int found;
+        bool quit;
+};
+/*Defines the arguments of a worker thread */
+typedef struct worker
+{
+        parallel_bfs *p;
+        int id;
+} worker;
+/**
+* push() - Add a node to a buffer.
+* @b: Buffer to manipulate.
+* @v: Node id.
+*
+* Returns: Nothing.
+*/
+static void push(buffer *b, uint32_t v)
+{
+        if (b->count == b->size)
+        {
+                b->size *= 2;
+                b->nodes = realloc(b->nodes, b->size * sizeof(*b->nodes));
+        }
+        b->nodes[b->count++] = v;
+}
+/**
+* expand() - Claim the unvisited neighbours of chunks of the current level.
+* @p: Search to use.
+* @id: Id of the calling thread.
+* @level: Number of the current level.
+*
+* Returns: Nothing.
+*/
+static void expand(parallel_bfs *p, int id, uint32_t level)
+{
+        const csr_graph *c = p->c;
+        const uint32_t *cur = p->levels[level % 2];
+        buffer *b = &p->buffers[id];
+        uint32_t epoch = p->epoch;
+        b->count = 0;
+        for (;;)
+        {
+                uint32_t first = __sync_fetch_and_add(&p->cursors[level % 2], CHUNK);
+                if (first >= p->level_size || __atomic_load_n(&p->found, __ATOMIC_RELAXED))
+                {
+                        return;
+                }
+                uint32_t last = first + CHUNK < p->level_size ? first + CHUNK : p->level_size;
+                for (uint32_t i = first; i < last; i++)
+                {
+                        uint32_t u = cur[i];
+                        for (uint32_t k = c->offsets[u]; k < c->offsets[u + 1]; k++)
+                        {
+                                uint32_t v = c->targets[k];
+                                uint32_t old = __atomic_load_n(&p->seen[v], __ATOMIC_RELAXED);
+                                //Only the thread whose swap succeeds adds v
+                                if (old != epoch &&
+                                    __sync_bool_compare_and_swap(&p->seen[v], old, epoch))
+                                {
+                                        if (v == p->dest)
+                                        {
+                                                __atomic_store_n(&p->found, 1, __ATOMIC_RELAXED);
+                                        }
+                                        push(b, v);
+                                }
+                        }
+                }
+        }
+}
+/**
+* search() - Run the levels of one query as one of the threads.
+* @p: Search to use.
+* @id: Id of the calling thread.
+*
+* Every thread reaches the same decision to stop, since the decision is
+* made from shared values between two barriers.
+*
+* Returns: Nothing.
+*/
+static void search(parallel_bfs *p, int id)
+{
+        for (uint32_t level = 0;; level++)
+        {
+                expand(p, id, level);
+                if (id == 0)
+                {     //No thread uses the next cursor until the next level
+                        p->cursors[(level + 1) % 2] = 0;
+                }
+                pthread_barrier_wait(&p->barrier);
+                //Copies the buffer to its place in the next level
+                uint32_t offset = 0;
+                uint32_t total = 0;
+                for (int i = 0; i < p->threads; i++)
+                {
+                        if (i == id)
+                        {
+                                offset = total;
+                        }
+                        total += p->buffers[i].count;
+                }
+                bool done = p->found || total == 0;
+                if (!done)
+                {
+                        memcpy(p->levels[(level + 1) % 2] + offset, p->buffers[id].nodes,
+                               p->buffers[id].count * sizeof(uint32_t));
+                }
+                if (id == 0)
+                {     //Nobody reads the level size between the barriers
+                        p->level_size = total;
+                }
+                //The next level is complete before anyone expands it
+                pthread_barrier_wait(&p->barrier);
+                if (done)
+                {
+                        return;
+                }
+        }
+}
+/**
+* work() - Answer queries until the search is killed.
+* @arg: Pointer to the worker of the thread.
+*
+* Returns: NULL.
+*/
+static void *work(void *arg)
+{
+        worker *w = arg;
+        parallel_bfs *p = w->p;
+        for (;;)
+        {
+                pthread_barrier_wait(&p->barrier);
+                if (p->quit)
+                {
+                        free(w);
+                        return NULL;
+                }
+                search(p, w->id);
+        }
+}
+/**
+* parallel_bfs_empty() - Start a pool of threads searching a frozen graph.
+* @c: Frozen graph to search.
+* @threads: Number of threads, or 0 for one per online processor.
+*
+* Returns: A pointer to the search.
+*/
+parallel_bfs *parallel_bfs_empty(const csr_graph *c, int threads)
+{
+        if (threads <= 0)
+        {
+                threads = sysconf(_SC_NPROCESSORS_ONLN);
+        }
+        if (threads <= 0)
+        {
+                threads = 1;
+        }
+        parallel_bfs *p = calloc(1, sizeof(*p));
+        p->c = c;
+        p->threads = threads;
+        p->seen = calloc(c->n + 1, sizeof(*p->seen));
+        p->levels[0] = malloc((c->n + 1) * sizeof(uint32_t));
+        p->levels[1] = malloc((c->n + 1) * sizeof(uint32_t));
+        p->buffers = malloc(threads * sizeof(*p->buffers));
+        for (int i = 0; i < threads; i++)
+        {
+                p->buffers[i].size = CHUNK;
+                p->buffers[i].count = 0;
+                p->buffers[i].nodes = malloc(CHUNK * sizeof(uint32_t));
+        }
+        pthread_barrier_init(&p->barrier, NULL, threads);
+        p->ids = malloc(threads * sizeof(*p->ids));
+        for (int i = 1; i < threads; i++)
+        {
+                worker *w = malloc(sizeof(*w));
+                w->p = p;
+                w->id = i;
+                pthread_create(&p->ids[i], NULL, work, w);
+        }
+        return p;
+}
+/**
+* parallel_bfs_path_exists() - Check if there is a path between two nodes.
+* @p: Search to use.
+* @src: Id of the origin node.
+* @dest: Id of the destination node.
+*
+* Returns: True if dest can be reached from src, otherwise false.
+*/
+bool parallel_bfs_path_exists(parallel_bfs *p, uint32_t src, uint32_t dest)
+{
+        if (src == dest)
+        {
+                return true;
+        }
+        p->epoch++;
+        if (p->epoch == 0)
+        {
+                //The counter wrapped, so old stamps could match again
+                memset(p->seen, 0, p->c->n * sizeof(*p->seen));
+                p->epoch = 1;
+        }
+        p->seen[src] = p->epoch;
+        p->levels[0][0] = src;
+        p->level_size = 1;
+        p->cursors[0] = 0;
+        p->dest = dest;
+        p->found = 0;
+        //Wakes the workers, then works as thread 0
+        if (p->threads > 1)
+        {
+                pthread_barrier_wait(&p->barrier);
+        }
+        search(p, 0);
+        return p->found;
+}
+/**
+* parallel_bfs_kill() - Stop the threads and destroy a search.
+* @p: Search to destroy.
+*
+* Returns: Nothing.
+*/
+void parallel_bfs_kill(parallel_bfs *p)
+{
+        p->quit = true;
+        if (p->threads > 1)
+        {
+                pthread_barrier_wait(&p->barrier);
+        }
+        for (int i = 1; i < p->threads; i++)
+        {
+                pthread_join(p->ids[i], NULL);
+        }
+        pthread_barrier_destroy(&p->barrier);
+        for (int i = 0; i < p->threads; i++)
+        {
+                free(p->buffers[i].nodes);
+        }
+        free(p->buffers);
+        free(p->ids);
+        free(p->levels[0]);
+        free(p->levels[1]);
+        free(p->seen);
+        free(p);
+}
@@ -0,0 +1,64 @@
+#ifndef __PARALLEL_BFS_H
+#define __PARALLEL_BFS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "csr.h"
+
+/*
+ * Declaration of a multithreaded breadth-first search over a frozen graph
+ * (see csr.h). A pool of worker threads is started once and then answers
+ * any number of queries. The visited marks are kept in the search, not in
+ * the nodes, so the frozen graph itself is only read. A search must only
+ * be used by one thread at a time. After use, the function
+ * parallel_bfs_kill() must be called to stop the threads and de-allocate
+ * the dynamic memory.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-07-03: v1.0, first public version.
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct parallel_bfs parallel_bfs;
+
+// =================== PARALLEL BFS INTERFACE ======================
+
+/**
+ * parallel_bfs_empty() - Start a pool of threads searching a frozen graph.
+ * @c: Frozen graph to search. Must not be killed before the search.
+ * @threads: Number of threads, or 0 for one per online processor. The
+ *           calling thread counts as one of them.
+ *
+ * Returns: A pointer to the search.
+ */
+parallel_bfs *parallel_bfs_empty(const csr_graph *c, int threads);
+
+/**
+ * parallel_bfs_path_exists() - Check if there is a path between two nodes.
+ * @p: Search to use.
+ * @src: Id of the origin node.
+ * @dest: Id of the destination node.
+ *
+ * Expands one level at a time. The nodes of a level are handed out to
+ * the threads in chunks, a node is claimed with an atomic
+ * compare-and-swap on its visited mark, and every thread collects the
+ * nodes it claims in its own buffer. The buffers are copied into the
+ * next level when all threads are done with the current one.
+ *
+ * Returns: True if dest can be reached from src, otherwise false.
+ */
+bool parallel_bfs_path_exists(parallel_bfs *p, uint32_t src, uint32_t dest);
+
+/**
+ * parallel_bfs_kill() - Stop the threads and destroy a search.
+ * @p: Search to destroy.
+ *
+ * Returns: Nothing.
+ */
+void parallel_bfs_kill(parallel_bfs *p);
+
+#endif
@@ -0,0 +1,463 @@
+#define _POSIX_C_SOURCE 200112L
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "csr.h"
+#include "scc.h"
+#include "pll.h"
+
+/*
+* Implementation of a 2-hop reachability index with pruned landmark
+* labeling. The labels hold hub ranks, so they are sorted by construction
+* and a query is a merge of two sorted arrays. The forward search from a
+* hub only adds to in-labels and the backward search only to out-labels,
+* so the two can run at the same time in different threads.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-07-06: v1.0, first public version.
+*   2022-07-14: v1.1, index files hold the fingerprint of their map.
+*/
+
+// First word of an index file.
+#define PLL_MAGIC 0x324c4c50
+// Directions of the searches from a hub.
+#define FORWARD 0
+#define BACKWARD 1
+
+/*Defines the index. The out-label of component c is
+out_hubs[out_offsets[c]..out_offsets[c+1]), and likewise for in-labels */
+struct pll_index
+{
+        uint32_t n;
+        uint32_t components;
+        uint32_t *component;
+        uint32_t *out_offsets;
+        uint32_t *out_hubs;
+        uint32_t *in_offsets;
+        uint32_t *in_hubs;
+};
+/*Defines a label while the index is built */
+typedef struct label
+{
+        uint32_t *hubs;
+        uint32_t count;
+        uint32_t size;
+} label;
+/*Defines the state shared by the searches while the index is built.
+seen and queue hold one array per direction */
+typedef struct builder
+{
+        const csr_graph *graphs[2];
+        label *out;
+        label *in;
+        uint32_t *seen[2];
+        uint32_t *queue[2];
+        uint32_t root;
+        uint32_t rank;
+        pthread_barrier_t barrier;
+        bool quit;
+} builder;
+/*Defines a component and the key it is ordered by */
+typedef struct hub_key
+{
+        uint64_t key;
+        uint32_t comp;
+} hub_key;
+/**
+* add_hub() - Append a hub to a label.
+* @l: Label to manipulate.
+* @rank: Rank of the hub, larger than all ranks in the label.
+*
+* Returns: Nothing.
+*/
+static void add_hub(label *l, uint32_t rank)
+{
+        if (l->count == l->size)
+        {
+                l->size = l->size > 0 ? 2 * l->size : 4;
+                l->hubs = realloc(l->hubs, l->size * sizeof(*l->hubs));
+        }
+        l->hubs[l->count++] = rank;
+}
+/**
+* intersects() - Check if two sorted arrays have an element in common.
+* @a: First array.
+* @na: Length of a.
+* @b: Second array.
+* @nb: Length of b.
+*
+* Returns: True if there is a common element, otherwise false.
+*/
+static bool intersects(const uint32_t *a, uint32_t na, const uint32_t *b,
+                       uint32_t nb)
+{
+        uint32_t i = 0;
+        uint32_t j = 0;
+        while (i < na && j < nb)
+        {
+                if (a[i] == b[j])
+                {
+                        return true;
+                }
+                if (a[i] < b[j])
+                {
+                        i++;
+                }
+                else
+                {
+                        j++;
+                }
+        }
+        return false;
+}
+/**
+* label_from() - Search from the current hub in one direction.
+* @b: Builder holding the hub.
+* @dir: FORWARD to add the hub to in-labels, BACKWARD for out-labels.
+*
+* A component is pruned, i.e. neither labelled nor expanded, if the
+* labels already show that the hub and the component are connected.
+*
+* Returns: Nothing.
+*/
+static void label_from(builder *b, int dir)
+{
+        const csr_graph *c = b->graphs[dir];
+        label *labels = dir == FORWARD ? b->in : b->out;
+        const label *root = dir == FORWARD ? &b->out[b->root] : &b->in[b->root];
+        uint32_t *seen = b->seen[dir];
+        uint32_t *queue = b->queue[dir];
+        //Each hub has its own rank, so rank+1 works as a search epoch
+        uint32_t stamp = b->rank + 1;
+        uint32_t head = 0;
+        uint32_t tail = 0;
+
+        seen[b->root] = stamp;
+        queue[tail++] = b->root;
+        while (head < tail)
+        {
+                uint32_t u = queue[head++];
+                if (u != b->root)
+                {
+                        if (intersects(root->hubs, root->count, labels[u].hubs, labels[u].count))
+                        {
+                                continue;
+                        }
+                        add_hub(&labels[u], b->rank);
+                }
+                for (uint32_t k = c->offsets[u]; k < c->offsets[u + 1]; k++)
+                {
+                        uint32_t v = c->targets[k];
+                        if (seen[v] != stamp)
+                        {
+                                seen[v] = stamp;
+                                queue[tail++] = v;
+                        }
+                }
+        }
+}
+/**
+* backward_worker() - Run the backward searches of every hub.
+* @arg: Pointer to the builder.
+*
+* Returns: NULL.
+*/
+static void *backward_worker(void *arg)
+{
+        builder *b = arg;
+        for (;;)
+        {
+                pthread_barrier_wait(&b->barrier);
+                if (b->quit)
+                {
+                        return NULL;
+                }
+                label_from(b, BACKWARD);
+                pthread_barrier_wait(&b->barrier);
+        }
+}
+/**
+* compare_keys() - Order hubs by decreasing key, then by component id.
+* @a: Pointer to the first hub_key.
+* @b: Pointer to the second hub_key.
+*
+* Returns: A negative number if a comes first, otherwise positive.
+*/
+static int compare_keys(const void *a, const void *b)
+{
+        const hub_key *x = a;
+        const hub_key *y = b;
+        if (x->key != y->key)
+        {
+                return x->key > y->key ? -1 : 1;
+        }
+        return x->comp < y->comp ? -1 : 1;
+}
+/**
+* pack() - Copy labels into one offset array and one hub array.
+* @labels: Labels to copy, which are freed.
+* @count: Number of labels.
+* @offsets: Set to the new offset array.
+* @hubs: Set to the new hub array.
+*
+* Returns: Nothing.
+*/
+static void pack(label *labels, uint32_t count, uint32_t **offsets,
+                 uint32_t **hubs)
+{
+        *offsets = malloc((count + 1) * sizeof(**offsets));
+        (*offsets)[0] = 0;
+        for (uint32_t c = 0; c < count; c++)
+        {
+                (*offsets)[c + 1] = (*offsets)[c] + labels[c].count;
+        }
+        *hubs = malloc(((*offsets)[count] + 1) * sizeof(**hubs));
+        for (uint32_t c = 0; c < count; c++)
+        {
+                for (uint32_t k = 0; k < labels[c].count; k++)
+                {
+                        (*hubs)[(*offsets)[c] + k] = labels[c].hubs[k];
+                }
+                free(labels[c].hubs);
+        }
+        free(labels);
+}
+/**
+* scc_labels() - Build a 2-hop index of a condensation.
+* @s: Components and condensation of a graph.
+* @threads: Number of threads, or 0 for one per online processor.
+*
+* Returns: A pointer to the index.
+*/
+pll_index *scc_labels(const scc_graph *s, int threads)
+{
+        uint32_t count = s->components;
+        csr_graph *reverse = csr_transpose(s->dag);
+        builder b;
+        b.graphs[FORWARD] = s->dag;
+        b.graphs[BACKWARD] = reverse;
+        b.out = calloc(count + 1, sizeof(label));
+        b.in = calloc(count + 1, sizeof(label));
+        b.quit = false;
+        for (int dir = 0; dir < 2; dir++)
+        {
+                b.seen[dir] = calloc(count + 1, sizeof(uint32_t));
+                b.queue[dir] = malloc((count + 1) * sizeof(uint32_t));
+        }
+        //Well connected components make the best hubs, so they go first
+        hub_key *order = malloc((count + 1) * sizeof(*order));
+        for (uint32_t c = 0; c < count; c++)
+        {
+                uint64_t out_degree = s->dag->offsets[c + 1] - s->dag->offsets[c];
+                uint64_t in_degree = reverse->offsets[c + 1] - reverse->offsets[c];
+                order[c].key = (in_degree + 1) * (out_degree + 1);
+                order[c].comp = c;
+        }
+        qsort(order, count, sizeof(*order), compare_keys);
+
+        pthread_t helper;
+        if (threads <= 0)
+        {
+                threads = sysconf(_SC_NPROCESSORS_ONLN);
+        }
+        bool parallel = threads >= 2;
+        if (parallel)
+        {
+                pthread_barrier_init(&b.barrier, NULL, 2);
+                pthread_create(&helper, NULL, backward_worker, &b);
+        }
+        for (uint32_t rank = 0; rank < count; rank++)
+        {
+                b.root = order[rank].comp;
+                b.rank = rank;
+                //The hub is in its own labels before either search starts
+                add_hub(&b.out[b.root], rank);
+                add_hub(&b.in[b.root], rank);
+                if (parallel)
+                {
+                        pthread_barrier_wait(&b.barrier);
+                        label_from(&b, FORWARD);
+                        pthread_barrier_wait(&b.barrier);
+                }
+                else
+                {
+                        label_from(&b, FORWARD);
+                        label_from(&b, BACKWARD);
+                }
+        }
+        if (parallel)
+        {
+                b.quit = true;
+                pthread_barrier_wait(&b.barrier);
+                pthread_join(helper, NULL);
+                pthread_barrier_destroy(&b.barrier);
+        }
+
+        pll_index *p = malloc(sizeof(*p));
+        p->n = s->n;
+        p->components = count;
+        p->component = malloc((s->n + 1) * sizeof(*p->component));
+        for (uint32_t i = 0; i < s->n; i++)
+        {
+                p->component[i] = s->component[i];
+        }
+        pack(b.out, count, &p->out_offsets, &p->out_hubs);
+        pack(b.in, count, &p->in_offsets, &p->in_hubs);
+        for (int dir = 0; dir < 2; dir++)
+        {
+                free(b.seen[dir]);
+                free(b.queue[dir]);
+        }
+        free(order);
+        csr_kill(reverse);
+        return p;
+}
+/**
+* pll_path_exists() - Check if there is a path between two nodes.
+* @p: Index to inspect.
+* @src: Id of the origin node.
+* @dest: Id of the destination node.
+*
+* Returns: True if dest can be reached from src, otherwise false.
+*/
+bool pll_path_exists(const pll_index *p, uint32_t src, uint32_t dest)
+{
+        uint32_t from = p->component[src];
+        uint32_t to = p->component[dest];
+        if (from == to)
+        {
+                return true;
+        }
+        //Components are numbered in reverse topological order
+        if (to > from)
+        {
+                return false;
+        }
+        return intersects(p->out_hubs + p->out_offsets[from],
+                          p->out_offsets[from + 1] - p->out_offsets[from],
+                          p->in_hubs + p->in_offsets[to],
+                          p->in_offsets[to + 1] - p->in_offsets[to]);
+}
+/**
+* pll_save() - Write an index to a file.
+* @p: Index to write.
+* @file: Name of the file.
+* @fingerprint: Fingerprint of the map the index was built from.
+*
+* The file holds a header of seven words (magic number, nodes, components,
+* out-label hubs, in-label hubs and the two halves of the fingerprint)
+* followed by the arrays.
+*
+* Returns: True if the index was written, otherwise false.
+*/
+bool pll_save(const pll_index *p, const char *file, uint64_t fingerprint)
+{
+        FILE *out = fopen(file, "wb");
+        if (out == NULL)
+        {
+                return false;
+        }
+        uint32_t c = p->components;
+        uint32_t header[7] = { PLL_MAGIC, p->n, c, p->out_offsets[c], p->in_offsets[c],
+                               (uint32_t)fingerprint, (uint32_t)(fingerprint >> 32) };
+        bool ok = fwrite(header, sizeof(uint32_t), 7, out) == 7
+                && fwrite(p->component, sizeof(uint32_t), p->n, out) == p->n
+                && fwrite(p->out_offsets, sizeof(uint32_t), c + 1, out) == c + 1
+                && fwrite(p->out_hubs, sizeof(uint32_t), header[3], out) == header[3]
+                && fwrite(p->in_offsets, sizeof(uint32_t), c + 1, out) == c + 1
+                && fwrite(p->in_hubs, sizeof(uint32_t), header[4], out) == header[4];
+        return fclose(out) == 0 && ok;
+}
+/**
+* read_words() - Allocate an array and read it from a file.
+* @in: File to read from.
+* @count: Number of words.
+*
+* Returns: A pointer to the array, or NULL if it could not be read.
+*/
+static uint32_t *read_words(FILE *in, uint32_t count)
+{
+        uint32_t *words = malloc(((size_t)count + 1) * sizeof(*words));
+        if (fread(words, sizeof(*words), count, in) != count)
+        {
+                free(words);
+                return NULL;
+        }
+        return words;
+}
+/**
+* pll_load() - Read an index from a file.
+* @file: Name of the file.
+* @n: Number of nodes of the graph the index is for.
+* @fingerprint: Fingerprint of the map the graph was read from.
+*
+* Returns: A pointer to the index, or NULL if the file can not be read
+* or does not hold an index for a graph with n nodes read from a map
+* with the same fingerprint.
+*/
+pll_index *pll_load(const char *file, uint32_t n, uint64_t fingerprint)
+{
+        FILE *in = fopen(file, "rb");
+        if (in == NULL)
+        {
+                return NULL;
+        }
+        uint32_t header[7];
+        if (fread(header, sizeof(uint32_t), 7, in) != 7 || header[0] != PLL_MAGIC
+            || header[1] != n || header[2] > n || header[5] != (uint32_t)fingerprint
+            || header[6] != (uint32_t)(fingerprint >> 32))
+        {
+                fclose(in);
+                return NULL;
+        }
+        pll_index *p = malloc(sizeof(*p));
+        p->n = n;
+        p->components = header[2];
+        p->component = read_words(in, n);
+        p->out_offsets = read_words(in, p->components + 1);
+        p->out_hubs = read_words(in, header[3]);
+        p->in_offsets = read_words(in, p->components + 1);
+        p->in_hubs = read_words(in, header[4]);
+        fclose(in);
+        bool ok = p->component && p->out_offsets && p->out_hubs && p->in_offsets
+                && p->in_hubs && p->out_offsets[p->components] == header[3]
+                && p->in_offsets[p->components] == header[4];
+        //Ids or offsets out of range would make queries read outside the arrays
+        for (uint32_t i = 0; ok && i < n; i++)
+        {
+                ok = p->component[i] < p->components;
+        }
+        for (uint32_t c = 0; ok && c < p->components; c++)
+        {
+                ok = p->out_offsets[c] <= p->out_offsets[c + 1]
+                        && p->in_offsets[c] <= p->in_offsets[c + 1];
+        }
+        if (!ok)
+        {
+                pll_kill(p);
+                return NULL;
+        }
+        return p;
+}
+/**
+* pll_kill() - Destroy a 2-hop index.
+* @p: Index to destroy.
+*
+* Returns: Nothing.
+*/
+void pll_kill(pll_index *p)
+{
+        free(p->component);
+        free(p->out_offsets);
+        free(p->out_hubs);
+        free(p->in_offsets);
+        free(p->in_hubs);
+        free(p);
+}
@@ -0,0 +1,90 @@
+#ifndef __PLL_H
+#define __PLL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "scc.h"
+
+/*
+ * Declaration of a 2-hop reachability index built with pruned landmark
+ * labeling (PLL) over the condensation of a graph (see scc.h). Every
+ * component c has an out-label, a sorted list of hubs that c can reach,
+ * and an in-label, a sorted list of hubs that can reach c. Node u can
+ * reach node v if their components are equal or the out-label of u and
+ * the in-label of v have a hub in common. The labels are usually short,
+ * so the index takes memory close to linear in the size of the graph,
+ * and a query intersects two short arrays. An index can be saved to a
+ * file and loaded again. After use, the function pll_kill() must be
+ * called to de-allocate its dynamic memory.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-07-06: v1.0, first public version.
+ *   2022-07-14: v1.1, index files hold the fingerprint of their map.
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct pll_index pll_index;
+
+// =================== PLL INTERFACE ======================
+
+/**
+ * scc_labels() - Build a 2-hop index of a condensation.
+ * @s: Components and condensation of a graph.
+ * @threads: Number of threads, or 0 for one per online processor. With
+ *           2 or more, the forward and backward search from each hub run
+ *           in two threads.
+ *
+ * The components are taken as hubs in order of decreasing
+ * (in-degree+1)*(out-degree+1). From each hub a forward and a backward
+ * search add the hub to the labels of the components they reach, but
+ * stop at components that the earlier hubs already connect to it.
+ *
+ * Returns: A pointer to the index.
+ */
+pll_index *scc_labels(const scc_graph *s, int threads);
+
+/**
+ * pll_path_exists() - Check if there is a path between two nodes.
+ * @p: Index to inspect.
+ * @src: Id of the origin node.
+ * @dest: Id of the destination node.
+ *
+ * Returns: True if dest can be reached from src, otherwise false.
+ */
+bool pll_path_exists(const pll_index *p, uint32_t src, uint32_t dest);
+
+/**
+ * pll_save() - Write an index to a file.
+ * @p: Index to write.
+ * @file: Name of the file.
+ * @fingerprint: Fingerprint of the map the index was built from.
+ *
+ * Returns: True if the index was written, otherwise false.
+ */
+bool pll_save(const pll_index *p, const char *file, uint64_t fingerprint);
+
+/**
+ * pll_load() - Read an index from a file.
+ * @file: Name of the file.
+ * @n: Number of nodes of the graph the index is for.
+ * @fingerprint: Fingerprint of the map the graph was read from.
+ *
+ * Returns: A pointer to the index, or NULL if the file can not be read
+ * or does not hold an index for a graph with n nodes read from a map
+ * with the same fingerprint.
+ */
+pll_index *pll_load(const char *file, uint32_t n, uint64_t fingerprint);
+
+/**
+ * pll_kill() - Destroy a 2-hop index.
+ * @p: Index to destroy.
+ *
+ * Returns: Nothing.
+ */
+void pll_kill(pll_index *p);
+
+#endif
@@ -0,0 +1,332 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bitset.h"
+#include "reach_cache.h"
+
+/*
+* Implementation of a cache of reachable sets. The entries are kept in a
+* doubly linked list, most recently used first, and an array over the
+* node ids maps an origin to its entry, so a lookup takes constant time.
+* The same array marks the origins that have missed but have no entry.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-07-08: v1.0, first public version.
+*   2022-07-14: v1.1, origins are cached from their second miss.
+*/
+
+// Marks the end of the list, or an origin without an entry.
+#define NONE -1
+// Marks an origin without an entry that has missed before.
+#define MISSED -2
+
+/*Defines the reachable set of one origin */
+typedef struct entry
+{
+        int origin;
+        int bits;
+        int words;
+        uint64_t *set;
+        int prev;
+        int next;
+} entry;
+/*Defines the cache */
+struct reach_cache
+{
+        int capacity;
+        int used;
+        entry *entries;
+        int head;
+        int tail;
+        //Entry of each origin id, or NONE or MISSED
+        int *slot;
+        int slot_size;
+        reach_cache_stats stats;
+};
+/**
+* unlink_entry() - Take an entry out of the list.
+* @c: Cache to manipulate.
+* @i: Index of the entry.
+*
+* Returns: Nothing.
+*/
+static void unlink_entry(reach_cache *c, int i)
+{
+        entry *e = &c->entries[i];
+        if (e->prev != NONE)
+        {
+                c->entries[e->prev].next = e->next;
+        }
+        else
+        {
+                c->head = e->next;
+        }
+        if (e->next != NONE)
+        {
+                c->entries[e->next].prev = e->prev;
+        }
+        else
+        {
+                c->tail = e->prev;
+        }
+}
+/**
+* push_front() - Put an entry first in the list.
+* @c: Cache to manipulate.
+* @i: Index of the entry, not in the list.
+*
+* Returns: Nothing.
+*/
+static void push_front(reach_cache *c, int i)
+{
+        entry *e = &c->entries[i];
+        e->prev = NONE;
+        e->next = c->head;
+        if (c->head != NONE)
+        {
+                c->entries[c->head].prev = i;
+        }
+        else
+        {
+                c->tail = i;
+        }
+        c->head = i;
+}
+/**
+* drop() - Remove an entry from the cache.
+* @c: Cache to manipulate.
+* @i: Index of the entry.
+*
+* The entries stay packed in entries[0] to entries[used - 1], so the last
+* one is moved into the hole. Its bitset memory is kept for later use.
+*
+* Returns: Nothing.
+*/
+static void drop(reach_cache *c, int i)
+{
+        unlink_entry(c, i);
+        //The origin has been queried, so it is admitted again at once
+        c->slot[c->entries[i].origin] = MISSED;
+        int last = --c->used;
+        if (i == last)
+        {
+                return;
+        }
+        entry moved = c->entries[last];
+        c->entries[last] = c->entries[i];
+        c->entries[i] = moved;
+        //Fixes the links and the slot of the moved entry
+        if (moved.prev != NONE)
+        {
+                c->entries[moved.prev].next = i;
+        }
+        else
+        {
+                c->head = i;
+        }
+        if (moved.next != NONE)
+        {
+                c->entries[moved.next].prev = i;
+        }
+        else
+        {
+                c->tail = i;
+        }
+        c->slot[moved.origin] = i;
+}
+/**
+* fit_slots() - Make room in the slot array for an origin id.
+* @c: Cache to manipulate.
+* @origin: Id of the origin node.
+*
+* Returns: Nothing.
+*/
+static void fit_slots(reach_cache *c, int origin)
+{
+        if (origin < c->slot_size)
+        {
+                return;
+        }
+        int size = c->slot_size > 0 ? c->slot_size : 16;
+        while (size <= origin)
+        {
+                size *= 2;
+        }
+        c->slot = realloc(c->slot, size * sizeof(*c->slot));
+        for (int i = c->slot_size; i < size; i++)
+        {
+                c->slot[i] = NONE;
+        }
+        c->slot_size = size;
+}
+/**
+* contains() - Check if the set of an entry contains a node id.
+* @e: Entry to inspect.
+* @id: Node id.
+*
+* Returns: True if id is in the set, otherwise false.
+*/
+static bool contains(const entry *e, int id)
+{
+        return id < e->bits && bitset_test(e->set, id);
+}
+/**
+* reach_cache_empty() - Create an empty cache.
+* @capacity: Largest number of origins kept.
+*
+* Returns: A pointer to the new cache.
+*/
+reach_cache *reach_cache_empty(int capacity)
+{
+        reach_cache *c = calloc(1, sizeof(*c));
+        c->capacity = capacity > 0 ? capacity : 1;
+        c->entries = calloc(c->capacity, sizeof(*c->entries));
+        c->head = NONE;
+        c->tail = NONE;
+        return c;
+}
+/**
+* reach_cache_test() - Answer a query from the cache.
+* @c: Cache to use. The origin becomes the most recently used.
+* @origin: Id of the origin node.
+* @dest: Id of the destination node.
+*
+* Returns: 1 if dest is reachable from origin, 0 if not, and -1 if the
+* origin is not in the cache.
+*/
+int reach_cache_test(reach_cache *c, int origin, int dest)
+{
+        if (origin >= c->slot_size || c->slot[origin] < 0)
+        {
+                c->stats.misses++;
+                return -1;
+        }
+        int i = c->slot[origin];
+        if (c->head != i)
+        {
+                unlink_entry(c, i);
+                push_front(c, i);
+        }
+        c->stats.hits++;
+        return contains(&c->entries[i], dest);
+}
+/**
+* reach_cache_admit() - Check if the set of an origin is worth caching.
+* @c: Cache to manipulate.
+* @origin: Id of the origin node, not in the cache.
+*
+* Returns: true if the origin has missed before, otherwise false.
+*/
+bool reach_cache_admit(reach_cache *c, int origin)
+{
+        fit_slots(c, origin);
+        if (c->slot[origin] == MISSED)
+        {
+                return true;
+        }
+        c->slot[origin] = MISSED;
+        return false;
+}
+/**
+* reach_cache_insert() - Make room for the reachable set of an origin.
+* @c: Cache to manipulate.
+* @origin: Id of the origin node, not in the cache.
+* @bits: Number of node ids in the graph.
+*
+* Returns: A cleared bitset of bits bits, to be filled in by the caller.
+*/
+uint64_t *reach_cache_insert(reach_cache *c, int origin, int bits)
+{
+        fit_slots(c, origin);
+        if (c->used == c->capacity)
+        {       //Evicts the least recently used origin
+                drop(c, c->tail);
+        }
+        int i = c->used++;
+        entry *e = &c->entries[i];
+        int words = bitset_words(bits);
+        if (words > e->words)
+        {
+                free(e->set);
+                e->set = bitset_empty(bits);
+                e->words = words;
+        }
+        else
+        {
+                bitset_clear(e->set, words);
+        }
+        e->origin = origin;
+        e->bits = bits;
+        c->slot[origin] = i;
+        push_front(c, i);
+        return e->set;
+}
+/**
+* reach_cache_edge_inserted() - Drop the sets an inserted edge can change.
+* @c: Cache to manipulate.
+* @src: Id of the source node of the edge.
+* @dest: Id of the destination node of the edge.
+*
+* Returns: Nothing.
+*/
+void reach_cache_edge_inserted(reach_cache *c, int src, int dest)
+{
+        //Goes backwards, since drop() moves the last entry into the hole
+        for (int i = c->used - 1; i >= 0; i--)
+        {
+                if (contains(&c->entries[i], src) && !contains(&c->entries[i], dest))
+                {
+                        drop(c, i);
+                        c->stats.dropped++;
+                }
+        }
+}
+/**
+* reach_cache_edge_deleted() - Drop the sets a deleted edge can change.
+* @c: Cache to manipulate.
+* @src: Id of the source node of the edge.
+*
+* Returns: Nothing.
+*/
+void reach_cache_edge_deleted(reach_cache *c, int src)
+{
+        for (int i = c->used - 1; i >= 0; i--)
+        {
+                if (contains(&c->entries[i], src))
+                {
+                        drop(c, i);
+                        c->stats.dropped++;
+                }
+        }
+}
+/**
+* reach_cache_get_stats() - Return the counters of a cache.
+* @c: Cache to inspect.
+*
+* Returns: The counters.
+*/
+reach_cache_stats reach_cache_get_stats(const reach_cache *c)
+{
+        return c->stats;
+}
+/**
+* reach_cache_kill() - Destroy a cache.
+* @c: Cache to destroy.
+*
+* Returns: Nothing.
+*/
+void reach_cache_kill(reach_cache *c)
+{
+        for (int i = 0; i < c->capacity; i++)
+        {
+                free(c->entries[i].set);
+        }
+        free(c->entries);
+        free(c->slot);
+        free(c);
+}
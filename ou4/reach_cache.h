@@ -0,0 +1,122 @@
+#ifndef __REACH_CACHE_H
+#define __REACH_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Declaration of a cache of reachable sets. For a bounded number of
+ * origin node ids it keeps a bitset of the node ids that the origin
+ * reaches, so repeated queries from the same origin are answered with a
+ * bit test. When the cache is full the least recently used origin is
+ * dropped. An origin is only worth a set once it is queried again, so the
+ * cache remembers the origins that have missed. After use, the function reach_cache_kill() must be called to
+ * de-allocate the dynamic memory of the cache.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-07-08: v1.0, first public version.
+ *   2022-07-14: v1.1, added reach_cache_admit().
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct reach_cache reach_cache;
+
+typedef struct reach_cache_stats {
+        long hits;              // Queries answered from the cache.
+        long misses;            // Queries whose origin was not cached.
+        long dropped;           // Sets dropped because an edge changed.
+} reach_cache_stats;
+
+// =================== REACH CACHE INTERFACE ======================
+
+/**
+ * reach_cache_empty() - Create an empty cache.
+ * @capacity: Largest number of origins kept.
+ *
+ * Returns: A pointer to the new cache.
+ */
+reach_cache *reach_cache_empty(int capacity);
+
+/**
+ * reach_cache_test() - Answer a query from the cache.
+ * @c: Cache to use. The origin becomes the most recently used.
+ * @origin: Id of the origin node.
+ * @dest: Id of the destination node.
+ *
+ * Counts a hit or a miss.
+ *
+ * Returns: 1 if dest is reachable from origin, 0 if not, and -1 if the
+ * origin is not in the cache.
+ */
+int reach_cache_test(reach_cache *c, int origin, int dest);
+
+/**
+ * reach_cache_admit() - Check if the set of an origin is worth caching.
+ * @c: Cache to manipulate.
+ * @origin: Id of the origin node, not in the cache.
+ *
+ * The first miss of an origin is remembered, and the caller should answer
+ * the query with a search that stops at the destination. An origin that
+ * misses again, or whose set was dropped, is worth its set.
+ *
+ * Returns: true if the origin has missed before, otherwise false.
+ */
+bool reach_cache_admit(reach_cache *c, int origin);
+
+/**
+ * reach_cache_insert() - Make room for the reachable set of an origin.
+ * @c: Cache to manipulate.
+ * @origin: Id of the origin node, not in the cache.
+ * @bits: Number of node ids in the graph.
+ *
+ * Node ids from bits and up are treated as not reachable, so nodes
+ * inserted later need no room in the set.
+ *
+ * Returns: A cleared bitset of bits bits, to be filled in by the caller.
+ */
+uint64_t *reach_cache_insert(reach_cache *c, int origin, int bits);
+
+/**
+ * reach_cache_edge_inserted() - Drop the sets an inserted edge can change.
+ * @c: Cache to manipulate.
+ * @src: Id of the source node of the edge.
+ * @dest: Id of the destination node of the edge.
+ *
+ * A set changes only if it contains src but not dest.
+ *
+ * Returns: Nothing.
+ */
+void reach_cache_edge_inserted(reach_cache *c, int src, int dest);
+
+/**
+ * reach_cache_edge_deleted() - Drop the sets a deleted edge can change.
+ * @c: Cache to manipulate.
+ * @src: Id of the source node of the edge.
+ *
+ * A set changes only if it contains src.
+ *
+ * Returns: Nothing.
+ */
+void reach_cache_edge_deleted(reach_cache *c, int src);
+
+/**
+ * reach_cache_get_stats() - Return the counters of a cache.
+ * @c: Cache to inspect.
+ *
+ * Returns: The counters.
+ */
+reach_cache_stats reach_cache_get_stats(const reach_cache *c);
+
+/**
+ * reach_cache_kill() - Destroy a cache.
+ * @c: Cache to destroy.
+ *
+ * Returns: Nothing.
+ */
+void reach_cache_kill(reach_cache *c);
+
+#endif
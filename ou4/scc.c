@@ -0,0 +1,236 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "graph.h"
+#include "csr.h"
+#include "scc.h"
+
+/*
+* Implementation of strongly connected components with a non-recursive
+* version of Tarjan's algorithm, and of the condensation DAG stored as a
+* CSR graph over the component ids.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-06-29: v1.0, first public version.
+*/
+
+// Marks a node that has not been visited, or has no component yet.
+#define NONE UINT32_MAX
+
+/*Defines a frame of the depth-first search: a node and the position of
+its next out-edge to follow */
+typedef struct frame
+{
+        uint32_t v;
+        graph_pos pos;
+} frame;
+/**
+* find_components() - Give every node the id of its component.
+* @g: Graph to inspect.
+* @component: Array of N component ids to fill in.
+*
+* A node on the Tarjan stack has been visited but has no component yet,
+* so no separate on-stack flag is needed.
+*
+* Returns: The number of components.
+*/
+static uint32_t find_components(const graph *g, uint32_t *component)
+{
+        uint32_t n = graph_node_count(g);
+        uint32_t *index = malloc((n + 1) * sizeof(*index));
+        uint32_t *low = malloc((n + 1) * sizeof(*low));
+        uint32_t *stack = malloc((n + 1) * sizeof(*stack));
+        frame *frames = malloc((n + 1) * sizeof(*frames));
+        uint32_t next_index = 0;
+        uint32_t components = 0;
+        uint32_t top = 0;
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+                index[i] = NONE;
+                component[i] = NONE;
+        }
+        for (uint32_t root = 0; root < n; root++)
+        {
+                if (index[root] != NONE)
+                {
+                        continue;
+                }
+                //Visits the root
+                int depth = 0;
+                index[root] = low[root] = next_index++;
+                stack[top++] = root;
+                frames[depth].v = root;
+                frames[depth].pos = graph_neighbour_first(g, graph_node_by_id(g, root));
+                while (depth >= 0)
+                {
+                        frame *f = &frames[depth];
+                        if (!graph_neighbour_is_end(g, f->pos))
+                        {
+                                uint32_t w = graph_node_id(g, graph_neighbour_inspect(g, f->pos));
+                                f->pos = graph_neighbour_next(g, f->pos);
+                                if (index[w] == NONE)
+                                {     //Descends into w, as a recursive call would
+                                        index[w] = low[w] = next_index++;
+                                        stack[top++] = w;
+                                        depth++;
+                                        frames[depth].v = w;
+                                        frames[depth].pos = graph_neighbour_first(g, graph_node_by_id(g, w));
+                                }
+                                else if (component[w] == NONE && index[w] < low[f->v])
+                                {     //w is on the stack
+                                        low[f->v] = index[w];
+                                }
+                                continue;
+                        }
+                        //All edges of v are followed, so v returns to its parent
+                        uint32_t v = f->v;
+                        if (low[v] == index[v])
+                        {     //v is the root of a component, which is on top of the stack
+                                uint32_t w;
+                                do
+                                {
+                                        w = stack[--top];
+                                        component[w] = components;
+                                } while (w != v);
+                                components++;
+                        }
+                        depth--;
+                        if (depth >= 0 && low[v] < low[frames[depth].v])
+                        {
+                                low[frames[depth].v] = low[v];
+                        }
+                }
+        }
+        free(index);
+        free(low);
+        free(stack);
+        free(frames);
+        return components;
+}
+/**
+* build_dag() - Build the condensation of a graph.
+* @g: Graph to inspect.
+* @s: Components of the graph.
+*
+* The nodes are first sorted by component, then the out-edges of each
+* component are collected with duplicates and self-loops removed.
+*
+* Returns: A pointer to the condensation.
+*/
+static csr_graph *build_dag(const graph *g, const scc_graph *s)
+{
+        uint32_t c_count = s->components;
+        csr_graph *dag = malloc(sizeof(*dag));
+        dag->n = c_count;
+        dag->offsets = malloc((c_count + 1) * sizeof(*dag->offsets));
+        //Counting sort of the node ids by component
+        uint32_t *start = calloc(c_count + 1, sizeof(*start));
+        uint32_t *members = malloc((s->n + 1) * sizeof(*members));
+        for (uint32_t i = 0; i < s->n; i++)
+        {
+                start[s->component[i] + 1]++;
+        }
+        for (uint32_t c = 0; c < c_count; c++)
+        {
+                start[c + 1] += start[c];
+        }
+        for (uint32_t i = 0; i < s->n; i++)
+        {
+                members[start[s->component[i]]++] = i;
+        }
+        //start[c] is now the end of component c, which starts where c-1 ends
+        uint32_t *added = malloc((c_count + 1) * sizeof(*added));
+        for (uint32_t c = 0; c < c_count; c++)
+        {
+                added[c] = NONE;
+        }
+        uint32_t size = c_count > 0 ? c_count : 1;
+        dag->targets = malloc(size * sizeof(*dag->targets));
+        dag->m = 0;
+        for (uint32_t c = 0; c < c_count; c++)
+        {
+                dag->offsets[c] = dag->m;
+                for (uint32_t k = c > 0 ? start[c - 1] : 0; k < start[c]; k++)
+                {
+                        graph_pos pos = graph_neighbour_first(g, graph_node_by_id(g, members[k]));
+                        while (!graph_neighbour_is_end(g, pos))
+                        {
+                                uint32_t d = s->component[graph_node_id(g, graph_neighbour_inspect(g, pos))];
+                                //added[d] == c if the edge c -> d is stored already
+                                if (d != c && added[d] != c)
+                                {
+                                        added[d] = c;
+                                        if (dag->m == size)
+                                        {
+                                                size *= 2;
+                                                dag->targets = realloc(dag->targets, size * sizeof(*dag->targets));
+                                        }
+                                        dag->targets[dag->m++] = d;
+                                }
+                                pos = graph_neighbour_next(g, pos);
+                        }
+                }
+        }
+        dag->offsets[c_count] = dag->m;
+        free(start);
+        free(members);
+        free(added);
+        return dag;
+}
+/**
+* graph_condense() - Find the components and condensation of a graph.
+* @g: Graph to inspect.
+*
+* Returns: A pointer to the components and condensation.
+*/
+scc_graph *graph_condense(const graph *g)
+{
+        scc_graph *s = malloc(sizeof(*s));
+        s->n = graph_node_count(g);
+        s->component = malloc((s->n + 1) * sizeof(*s->component));
+        s->components = find_components(g, s->component);
+        s->dag = build_dag(g, s);
+        return s;
+}
+/**
+* scc_path_exists() - Check if there is a path between two nodes.
+* @s: Components and condensation to search.
+* @search: Scratch space for searches over s->dag.
+* @src: Id of the origin node.
+* @dest: Id of the destination node.
+*
+* Returns: True if dest can be reached from src, otherwise false.
+*/
+bool scc_path_exists(const scc_graph *s, csr_search *search, uint32_t src,
+                     uint32_t dest)
+{
+        uint32_t from = s->component[src];
+        uint32_t to = s->component[dest];
+        if (from == to)
+        {
+                return true;
+        }
+        //DAG edges only lead to lower component ids
+        if (to > from)
+        {
+                return false;
+        }
+        return csr_path_exists(s->dag, search, from, to);
+}
+/**
+* scc_kill() - Destroy components and condensation.
+* @s: Structure to destroy.
+*
+* Returns: Nothing.
+*/
+void scc_kill(scc_graph *s)
+{
+        csr_kill(s->dag);
+        free(s->component);
+        free(s);
+}
@@ -0,0 +1,73 @@
+#ifndef __SCC_H
+#define __SCC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+#include "csr.h"
+
+/*
+ * Declaration of the strongly connected components (SCCs) of a graph and
+ * its condensation, the graph with one node per component and an edge
+ * between two components if any of their nodes are joined by an edge.
+ * The condensation is a directed acyclic graph (DAG). The components are
+ * numbered in reverse topological order, so every DAG edge goes from a
+ * higher to a lower component id. Like a frozen graph (see csr.h) it is
+ * not updated when the graph changes. After use, the function scc_kill()
+ * must be called to de-allocate its dynamic memory.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-06-29: v1.0, first public version.
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct scc_graph {
+        uint32_t n;             // Number of nodes in the graph.
+        uint32_t components;    // Number of components.
+        uint32_t *component;    // Component id of each node id.
+        csr_graph *dag;         // Condensation over the component ids.
+} scc_graph;
+
+// =================== SCC INTERFACE ======================
+
+/**
+ * graph_condense() - Find the components and condensation of a graph.
+ * @g: Graph to inspect.
+ *
+ * Uses Tarjan's algorithm with an explicit stack of neighbour iterator
+ * positions instead of recursion, so deep graphs can not overflow the
+ * call stack. Takes O(N+E) time.
+ *
+ * Returns: A pointer to the components and condensation.
+ */
+scc_graph *graph_condense(const graph *g);
+
+/**
+ * scc_path_exists() - Check if there is a path between two nodes.
+ * @s: Components and condensation to search.
+ * @search: Scratch space for searches over s->dag.
+ * @src: Id of the origin node.
+ * @dest: Id of the destination node.
+ *
+ * Answers at once if the nodes are in the same component, or if the
+ * component of dest comes before the component of src in topological
+ * order. Otherwise the DAG is searched.
+ *
+ * Returns: True if dest can be reached from src, otherwise false.
+ */
+bool scc_path_exists(const scc_graph *s, csr_search *search, uint32_t src,
+                     uint32_t dest);
+
+/**
+ * scc_kill() - Destroy components and condensation.
+ * @s: Structure to destroy.
+ *
+ * Returns: Nothing.
+ */
+void scc_kill(scc_graph *s);
+
+#endif
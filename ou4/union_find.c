@@ -0,0 +1,147 @@
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "union_find.h"
+
+/*
+* Implementation of a union-find structure with union by rank and path
+* compression. The parent and rank arrays grow by doubling as elements
+* are added.
+*
+* Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+*          Henrik Linder (tfy18hlr@cs.umu.se)
+*
+* Version information:
+*   2022-06-28: v1.0, first public version.
+*/
+
+/*Defines the structure. Element x is a root if parent[x] == x */
+struct union_find
+{
+        int *parent;
+        unsigned char *rank;
+        int n;
+        int capacity;
+};
+/**
+* union_find_empty() - Create a union-find structure without elements.
+* @capacity: Expected number of elements, or 0 if unknown.
+*
+* Returns: A pointer to the new structure.
+*/
+union_find *union_find_empty(int capacity)
+{
+        union_find *u = malloc(sizeof(*u));
+        u->n = 0;
+        u->capacity = capacity > 0 ? capacity : 16;
+        u->parent = malloc(u->capacity * sizeof(*u->parent));
+        u->rank = malloc(u->capacity * sizeof(*u->rank));
+        return u;
+}
+/**
+* union_find_add() - Add a new element in a set of its own.
+* @u: Structure to manipulate.
+*
+* Returns: The new element.
+*/
+int union_find_add(union_find *u)
+{
+        if (u->n == u->capacity)
+        {
+                u->capacity *= 2;
+                u->parent = realloc(u->parent, u->capacity * sizeof(*u->parent));
+                u->rank = realloc(u->rank, u->capacity * sizeof(*u->rank));
+        }
+        u->parent[u->n] = u->n;
+        u->rank[u->n] = 0;
+        return u->n++;
+}
+/**
+* union_find_find() - Return the representative of the set of an element.
+* @u: Structure to manipulate.
+* @x: Element.
+*
+* Returns: The representative element.
+*/
+int union_find_find(union_find *u, int x)
+{
+        int root = x;
+        while (u->parent[root] != root)
+        {
+                root = u->parent[root];
+        }
+        //Second pass points every element on the path directly at the root
+        while (u->parent[x] != root)
+        {
+                int next = u->parent[x];
+                u->parent[x] = root;
+                x = next;
+        }
+        return root;
+}
+/**
+* union_find_union() - Merge the sets of two elements.
+* @u: Structure to manipulate.
+* @a: First element.
+* @b: Second element.
+*
+* Returns: True if two different sets were merged, otherwise false.
+*/
+bool union_find_union(union_find *u, int a, int b)
+{
+        a = union_find_find(u, a);
+        b = union_find_find(u, b);
+        if (a == b)
+        {
+                return false;
+        }
+        //The root of lower rank is put below the other one
+        if (u->rank[a] < u->rank[b])
+        {
+                u->parent[a] = b;
+        }
+        else if (u->rank[a] > u->rank[b])
+        {
+                u->parent[b] = a;
+        }
+        else
+        {
+                u->parent[b] = a;
+                u->rank[a]++;
+        }
+        return true;
+}
+/**
+* union_find_same() - Check if two elements are in the same set.
+* @u: Structure to manipulate.
+* @a: First element.
+* @b: Second element.
+*
+* Returns: True if the elements are in the same set, otherwise false.
+*/
+bool union_find_same(union_find *u, int a, int b)
+{
+        return union_find_find(u, a) == union_find_find(u, b);
+}
+/**
+* union_find_clear() - Remove all elements.
+* @u: Structure to manipulate.
+*
+* Returns: Nothing.
+*/
+void union_find_clear(union_find *u)
+{
+        u->n = 0;
+}
+/**
+* union_find_kill() - Destroy a union-find structure.
+* @u: Structure to destroy.
+*
+* Returns: Nothing.
+*/
+void union_find_kill(union_find *u)
+{
+        free(u->parent);
+        free(u->rank);
+        free(u);
+}
@@ -0,0 +1,89 @@
+#ifndef __UNION_FIND_H
+#define __UNION_FIND_H
+
+#include <stdbool.h>
+
+/*
+ * Declaration of a union-find (disjoint set) structure over the
+ * elements 0, 1, 2, ... Elements are added one at a time and start in
+ * a set of their own. Uses union by rank and path compression, so a
+ * sequence of operations costs nearly constant time per operation.
+ * After use, the function union_find_kill() must be called to
+ * de-allocate the dynamic memory used by the structure.
+ *
+ * Authors: Isak Mikaelsson (tfy20imn@cs.umu.se)
+ *          Henrik Linder (tfy18hlr@cs.umu.se)
+ *
+ * Version information:
+ *   2022-06-28: v1.0, first public version.
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct union_find union_find;
+
+// =================== UNION-FIND INTERFACE ======================
+
+/**
+ * union_find_empty() - Create a union-find structure without elements.
+ * @capacity: Expected number of elements, or 0 if unknown.
+ *
+ * Returns: A pointer to the new structure.
+ */
+union_find *union_find_empty(int capacity);
+
+/**
+ * union_find_add() - Add a new element in a set of its own.
+ * @u: Structure to manipulate.
+ *
+ * Returns: The new element, i.e. the number of elements before the call.
+ */
+int union_find_add(union_find *u);
+
+/**
+ * union_find_find() - Return the representative of the set of an element.
+ * @u: Structure to manipulate (paths are compressed).
+ * @x: Element.
+ *
+ * Returns: The representative element.
+ */
+int union_find_find(union_find *u, int x);
+
+/**
+ * union_find_union() - Merge the sets of two elements.
+ * @u: Structure to manipulate.
+ * @a: First element.
+ * @b: Second element.
+ *
+ * Returns: True if two different sets were merged, false if the
+ * elements already were in the same set.
+ */
+bool union_find_union(union_find *u, int a, int b);
+
+/**
+ * union_find_same() - Check if two elements are in the same set.
+ * @u: Structure to manipulate (paths are compressed).
+ * @a: First element.
+ * @b: Second element.
+ *
+ * Returns: True if the elements are in the same set, otherwise false.
+ */
+bool union_find_same(union_find *u, int a, int b);
+
+/**
+ * union_find_clear() - Remove all elements.
+ * @u: Structure to manipulate.
+ *
+ * Returns: Nothing.
+ */
+void union_find_clear(union_find *u);
+
+/**
+ * union_find_kill() - Destroy a union-find structure.
+ * @u: Structure to destroy.
+ *
+ * Returns: Nothing.
+ */
+void union_find_kill(union_find *u);
+
+#endif